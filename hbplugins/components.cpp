@@ -0,0 +1,108 @@
+/**
+ * @brief HostBoot's component names.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hbplugins.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace eSEL
+{
+
+/**
+ * @struct Component
+ * @brief Component description: ID and name.
+ */
+struct Component
+{
+    uint16_t id;
+    const char* name;
+};
+
+/** @brief Components list in the order of hbotcompid.H. */
+static constexpr Component ComponentList[] = {
+// Generated from hbotcompid.H, see Makefile.am
+#include "components.inc"
+};
+
+/** @brief Number of known components. */
+static constexpr size_t ComponentCount =
+    sizeof(ComponentList) / sizeof(ComponentList[0]);
+
+/** @brief Components sorted by ID at compile time (stable insertion sort,
+ *         the first entry wins if the ID is declared more than once). */
+static constexpr std::array<Component, ComponentCount> Components = []() {
+    std::array<Component, ComponentCount> sorted{};
+    for (size_t i = 0; i < ComponentCount; ++i)
+    {
+        size_t pos = i;
+        while (pos && sorted[pos - 1].id > ComponentList[i].id)
+        {
+            sorted[pos] = sorted[pos - 1];
+            --pos;
+        }
+        sorted[pos] = ComponentList[i];
+    }
+    return sorted;
+}();
+
+/**
+ * @brief Get name for unknown component.
+ *        Names are cached, so the returned view is valid until the end of
+ *        the program.
+ *
+ * @param[in] id - component id
+ *
+ * @return component name in "Unknown [0xXXXX]" format
+ */
+static std::string_view getUnknownName(uint16_t id)
+{
+    static std::unordered_map<uint16_t, std::string> cache;
+    static std::shared_mutex mutex;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        const auto it = cache.find(id);
+        if (it != cache.end())
+            return it->second;
+    }
+
+    char buf[24];
+    snprintf(buf, sizeof(buf), "Unknown [0x%04" PRIx16 "]", id);
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    // Map's nodes are never moved, so the string stays in place
+    return cache.emplace(id, buf).first->second;
+}
+
+std::string_view getComponentName(uint16_t id)
+{
+    const auto it = std::lower_bound(
+        Components.begin(), Components.end(), id,
+        [](const Component& comp, uint16_t key) { return comp.id < key; });
+    if (it != Components.end() && it->id == id)
+        return it->name;
+    return getUnknownName(id);
+}
+
+} // namespace eSEL
@@ -17,15 +17,22 @@
  */
 
 #include "errlplugins.hpp"
+#include "hbplugins.hpp"
+#include "spawn.hpp"
+#include "trace_decoder.hpp"
 
 #include <hbotcompid.H>
-#include <unistd.h>
 
-#include <climits>
+#include <charconv>
 #include <cstdio>
-#include <filesystem>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <system_error>
+#include <tuple>
 #include <vector>
 
 namespace eSEL
@@ -38,105 +45,174 @@ static std::string OCCStringFile = DEFAULT_OCC_STRINGS;
 /** @brief Path to FSP trace utility */
 static std::string FspUtil = DEFAULT_FSP_TRACE;
 
+/** @brief Resolved path to FSP trace utility, empty if not resolved yet. */
+static std::string FspUtilPath;
+/** @brief Mutex to guard resolved path. */
+static std::mutex FspUtilPathMutex;
+
 /**
- * @class TempFile
- * @brief Temporary file.
+ * @brief Get path to FSP trace utility, it is resolved once.
+ *
+ * @return path to the utility
  */
-class TempFile
+static std::string getFspUtilPath()
 {
-  public:
-    TempFile() : fd_(-1)
-    {
-    }
+    std::lock_guard<std::mutex> lock(FspUtilPathMutex);
+    if (FspUtilPath.empty())
+        FspUtilPath = resolveUtility(FspUtil);
+    return FspUtilPath;
+}
 
-    ~TempFile()
-    {
-        close();
-    }
+/** @brief Loaded string files: path -> string table, null if the file can
+ *         not be loaded. */
+static std::map<std::string, std::unique_ptr<TraceStrings>> TraceStringFiles;
+/** @brief Mutex to guard string files loading. */
+static std::mutex TraceStringFilesMutex;
 
-    /**
-     * @brief Create file.
-     */
-    void create()
+/**
+ * @brief Get string table, the file is loaded once.
+ *
+ * @param[in] stringFile - path to the string file
+ *
+ * @return pointer to the string table or nullptr if it can not be loaded
+ */
+static const TraceStrings* getTraceStrings(const std::string& stringFile)
+{
+    std::lock_guard<std::mutex> lock(TraceStringFilesMutex);
+
+    auto it = TraceStringFiles.find(stringFile);
+    if (it == TraceStringFiles.end())
     {
-        // Create temporary file
-        char tmpTemplate[] = "/tmp/fsptrace_XXXXXX";
-        fd_ = mkstemp(tmpTemplate);
-        if (fd_ == -1)
+        std::unique_ptr<TraceStrings> strings;
+        try
         {
-            throw std::system_error(errno, std::system_category(),
-                                    "Unable to create temporary file");
+            strings = std::make_unique<TraceStrings>(stringFile.c_str());
         }
-
-        // Get absolute path to the temporary file
-        std::string link = std::string("/proc/self/fd/") + std::to_string(fd_);
-        char path[PATH_MAX];
-        const ssize_t len = readlink(link.c_str(), path, sizeof(path));
-        if (len == -1)
+        catch (const std::exception&)
         {
-            throw std::system_error(errno, std::system_category(),
-                                    "Unable to get temporary file name");
+            // Native decoding is not possible, fsp-trace reports the error
         }
-        path_.assign(path, path + len);
+        it = TraceStringFiles.emplace(stringFile, std::move(strings)).first;
     }
 
-    /**
-     * @brief Write data to temporary file.
-     *
-     * @param[in] buffer - source data buffer
-     * @param[in] len - length of the buffer in bytes
-     */
-    void write(const uint8_t* buffer, size_t len)
+    return it->second.get();
+}
+
+/**
+ * @brief Run FSP trace utility.
+ *
+ * @param[in] buffer - raw log buffer
+ * @param[in] len - length of the buffer
+ * @param[in] stringFile - string file
+ * @param[out] trace - output of the utility
+ *
+ * @throws std::system_error if utility failed
+ */
+static void runFspTrace(const uint8_t* buffer, size_t len,
+                        const std::string& stringFile, std::string& trace)
+{
+    // Log is passed as a file, FSP trace doesn't support reading stdin
+    MemFile logFile("fsptrace");
+    logFile.write(buffer, len);
+
+    const std::vector<std::string> args = {"--file_name", "--stringfile",
+                                           stringFile, SpawnInputPath};
+    const int rc = spawnUtility(getFspUtilPath(), args, &logFile, trace);
+    if (rc)
     {
-        size_t pos = 0;
-        while (pos < len)
-        {
-            const ssize_t written = ::write(fd_, buffer + pos, len - pos);
-            if (written == -1)
-            {
-                throw std::system_error(errno, std::system_category(),
-                                        "Unable to write temporary file");
-            }
-            pos += written;
-        }
+        throw std::system_error(rc, std::system_category(),
+                                "Wrong FSP exit code");
     }
+}
 
-    /**
-     * @brief Close file.
-     */
-    void close()
+/**
+ * @struct BatchTrace
+ * @brief Trace prepared in batch mode.
+ */
+struct BatchTrace
+{
+    std::string output; ///< Decoded trace
+    bool native;        ///< Trace is decoded natively, not by FSP utility
+    size_t uses;        ///< Number of sections waiting for the trace
+};
+
+/** @brief Key of prepared trace: address and size of the buffer, string
+ *         file. The buffer is not copied, it is kept by the section. */
+using BatchKey = std::tuple<const uint8_t*, size_t, std::string>;
+
+/** @brief Traces prepared in batch mode, each entry is removed when all
+ *         sections that wait for it are decoded. */
+static std::map<BatchKey, BatchTrace> BatchTraces;
+/** @brief Mutex to guard batch traces. */
+static std::mutex BatchTracesMutex;
+
+/**
+ * @brief Get key for batch traces map.
+ *
+ * @param[in] buffer - raw log buffer
+ * @param[in] len - length of the buffer
+ * @param[in] stringFile - string file
+ *
+ * @return key
+ */
+static BatchKey batchKey(const uint8_t* buffer, size_t len,
+                         const std::string& stringFile)
+{
+    return BatchKey(buffer, len, stringFile);
+}
+
+/**
+ * @brief Take prepared trace.
+ *
+ * @param[in] buffer - raw log buffer
+ * @param[in] len - length of the buffer
+ * @param[in] stringFile - string file
+ * @param[out] trace - prepared trace
+ *
+ * @return false if trace was not prepared
+ */
+static bool takeBatchTrace(const uint8_t* buffer, size_t len,
+                           const std::string& stringFile, BatchTrace& trace)
+{
+    std::lock_guard<std::mutex> lock(BatchTracesMutex);
+    if (BatchTraces.empty())
+        return false;
+    const auto it = BatchTraces.find(batchKey(buffer, len, stringFile));
+    if (it == BatchTraces.end())
+        return false;
+    if (--it->second.uses)
+        trace = it->second;
+    else
     {
-        if (fd_ != -1)
-        {
-            ::close(fd_);
-            fd_ = -1;
-            if (!path_.empty())
-            {
-                remove(path_.c_str());
-                path_.clear();
-            }
-        }
+        trace = std::move(it->second);
+        BatchTraces.erase(it);
     }
+    return true;
+}
 
-    /**
-     * @brief Get absolute path to the file.
-     *
-     * @return path
-     */
-    const std::string& path() const
+/**
+ * @brief Save prepared trace.
+ *
+ * @param[in] key - key of the trace
+ * @param[in] output - decoded trace
+ * @param[in] native - flag of natively decoded trace
+ */
+static void putBatchTrace(BatchKey&& key, std::string&& output, bool native)
+{
+    std::lock_guard<std::mutex> lock(BatchTracesMutex);
+    BatchTrace& trace = BatchTraces[std::move(key)];
+    if (!trace.uses)
     {
-        return path_;
+        trace.output = std::move(output);
+        trace.native = native;
     }
-
-  private:
-    /** @brief File descriptor. */
-    int fd_;
-    /** @brief Absolute path to the file. */
-    std::string path_;
-};
+    ++trace.uses;
+}
 
 /**
  * @brief Get trace.
+ *        Trace is decoded natively, FSP trace utility is used as a fallback
+ *        for unsupported formats.
  *
  * @param[in] cb - callback for user parser (param collector)
  * @param[in] buffer - raw log buffer
@@ -148,87 +224,217 @@ class TempFile
 static bool fspTrace(ErrlUsrParser& cb, const uint8_t* buffer, size_t len,
                      const std::string& stringFile)
 {
+    BatchTrace batch;
+    if (takeBatchTrace(buffer, len, stringFile, batch))
+    {
+        if (!batch.native)
+            cb.PrintString("FSP trace utility", FspUtil.c_str());
+        cb.PrintString("String file", stringFile.c_str());
+        cb.PrintTrace(batch.output.c_str());
+        return true;
+    }
+
     std::string trace;
 
+    const TraceStrings* strings = getTraceStrings(stringFile);
+    if (strings && decodeTrace(buffer, len, *strings, trace))
+    {
+        cb.PrintString("String file", stringFile.c_str());
+        cb.PrintTrace(trace.c_str());
+        return true;
+    }
+    trace.clear();
+
     cb.PrintString("FSP trace utility", FspUtil.c_str());
     cb.PrintString("String file", stringFile.c_str());
 
     try
     {
-        // We have to create a real file to pass it to FSP trace
-        TempFile logFile;
-        logFile.create();
-        logFile.write(buffer, len);
-
-        // Define path to fsp-trace utility, allow using the program from
-        // current directory if absolute path is not specified
-        std::string fspUtilPath = FspUtil;
-        if (FspUtil.find('/') == std::string::npos)
-        {
-            const auto cwdFspUtil = std::filesystem::current_path() / FspUtil;
-            const auto fsStatus = std::filesystem::status(cwdFspUtil);
-            if (std::filesystem::exists(fsStatus) &&
-                std::filesystem::is_regular_file(fsStatus))
-            {
-                // Must be executable
-                const auto exec = fsStatus.permissions() &
-                                  (std::filesystem::perms::owner_exec |
-                                   std::filesystem::perms::group_exec |
-                                   std::filesystem::perms::others_exec);
-                if (exec != std::filesystem::perms::none)
-                    fspUtilPath = cwdFspUtil;
-            }
-        }
+        runFspTrace(buffer, len, stringFile, trace);
+        cb.PrintTrace(trace.c_str());
+    }
+    catch (const std::exception& e)
+    {
+        cb.PrintString("Error", e.what());
+        if (!trace.empty())
+            cb.PrintString("Output message", trace.c_str());
+        reportPluginError(FspUtil + ": " + e.what());
+        return false;
+    }
 
-        // Command to run FSP trace
-        std::string traceCommand = fspUtilPath;
-        traceCommand += " --file_name";
-        traceCommand += " --stringfile \"" + stringFile + '\"';
-        traceCommand += " \"" + logFile.path() + '\"';
-        traceCommand += " 2>&1";
+    return true;
+}
 
-        // Run FSP trace and read output
-        FILE* pipeOut = popen(traceCommand.c_str(), "r");
-        if (!pipeOut)
+/** @brief OCC trace subtype. */
+static constexpr uint8_t OccTraceSubtype = 0;
+/** @brief Size of header that OCC adds to trace, see OCC src for details. */
+static constexpr uint32_t OccTraceHeaderSize = 0x7c;
+
+/**
+ * @struct TraceSource
+ * @brief Trace data of User Defined section.
+ */
+struct TraceSource
+{
+    const uint8_t* buffer;         ///< Trace buffers
+    size_t len;                    ///< Size of trace buffers in bytes
+    const std::string* stringFile; ///< String file
+};
+
+/**
+ * @brief Get trace data from User Defined section.
+ *
+ * @param[in] cid - component ID
+ * @param[in] sst - subsection type ID
+ * @param[in] buffer - section data
+ * @param[in] len - length of the section data in bytes
+ * @param[out] source - trace data
+ *
+ * @return false if section doesn't contain trace
+ */
+static bool getTraceSource(uint16_t cid, uint8_t sst, const void* buffer,
+                           size_t len, TraceSource& source)
+{
+    const uint8_t* data = static_cast<const uint8_t*>(buffer);
+    if (cid == FIPS_ERRL_COMP_ID && sst == FIPS_ERRL_UDT_HB_TRACE)
+    {
+        source = {data, len, &HBStringFile};
+        return true;
+    }
+    if (cid == OCCC_COMP_ID && sst == OccTraceSubtype &&
+        len >= OccTraceHeaderSize)
+    {
+        // OCC adds a header, just skip it
+        source = {data + OccTraceHeaderSize, len - OccTraceHeaderSize,
+                  &OCCStringFile};
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Decode traces by single run of FSP trace utility.
+ *        Buffers get unique names, so the output can be split back by them.
+ *        Sections, which traces are not found in the output, are left to be
+ *        decoded separately.
+ *
+ * @param[in] stringFile - string file
+ * @param[in] sources - traces to decode
+ */
+static void batchFspTrace(const std::string& stringFile,
+                          const std::vector<TraceSource>& sources)
+{
+    // Tags used as buffer names: fixed size, so one can't be a prefix of
+    // another one
+    static constexpr char TagPrefix[] = "@ESEL";
+    static constexpr size_t TagDigits = 6;
+    static constexpr size_t TagLen = sizeof(TagPrefix) - 1 + TagDigits;
+
+    std::vector<uint8_t> data;
+    std::vector<size_t> owners;      // buffer -> index of source
+    std::vector<std::string> names;  // buffer -> original name
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        const TraceSource& src = sources[i];
+        const size_t pos = data.size();
+        const size_t buffers = owners.size();
+        data.insert(data.end(), src.buffer, src.buffer + src.len);
+        const bool rc = renameTraceBuffers(
+            data.data() + pos, src.len, [&](std::string_view name) {
+                char tag[TagLen + 1];
+                snprintf(tag, sizeof(tag), "%s%0*zu", TagPrefix,
+                         static_cast<int>(TagDigits), owners.size());
+                owners.push_back(i);
+                names.emplace_back(name);
+                return std::string(tag);
+            });
+        if (!rc)
         {
-            throw std::system_error(errno, std::system_category(),
-                                    "Unable to open pipe");
+            // Not a valid trace, leave it for the regular way
+            data.resize(pos);
+            owners.resize(buffers);
+            names.resize(buffers);
         }
+    }
+    if (owners.empty())
+        return;
+
+    std::string trace;
+    try
+    {
+        runFspTrace(data.data(), data.size(), stringFile, trace);
+    }
+    catch (const std::exception&)
+    {
+        return; // errors will be reported for each section
+    }
 
-        char pipeData[128]; // max line size, that fsp-trace prints
-        while (!feof(pipeOut))
+    // Split the output: lines before the first tag are common header, lines
+    // without a tag belong to the previous tagged line
+    std::string header;
+    std::vector<std::string> outputs(sources.size());
+    std::vector<bool> found(sources.size(), false);
+    size_t current = sources.size();
+    size_t pos = 0;
+    while (pos < trace.size())
+    {
+        const size_t eol = std::min(trace.find('\n', pos), trace.size());
+        std::string line = trace.substr(pos, eol - pos + 1);
+        pos = eol + 1;
+
+        const size_t tagPos = line.find(TagPrefix);
+        size_t buffer = owners.size();
+        if (tagPos != std::string::npos && tagPos + TagLen <= line.size())
         {
-            const size_t rb = fread(pipeData, 1, sizeof(pipeData), pipeOut);
-            if (rb)
-                trace.append(pipeData, pipeData + rb);
+            const char* digits = line.c_str() + tagPos + TagLen - TagDigits;
+            const auto rc = std::from_chars(digits, digits + TagDigits, buffer);
+            if (rc.ec != std::errc() || rc.ptr != digits + TagDigits)
+                buffer = owners.size();
         }
-        const int rc = pclose(pipeOut);
-        if (rc)
+        if (buffer < owners.size())
         {
-            throw std::system_error(rc, std::system_category(),
-                                    "Wrong FSP exit code");
+            // Restore original name, keep alignment if possible
+            size_t end = tagPos + TagLen;
+            while (end < line.size() && line[end] == ' ')
+                ++end;
+            std::string name = names[buffer];
+            if (name.size() < end - tagPos)
+                name.resize(end - tagPos, ' ');
+            line.replace(tagPos, end - tagPos, name);
+
+            current = owners[buffer];
+            if (!found[current])
+            {
+                found[current] = true;
+                outputs[current] = header;
+            }
         }
-        cb.PrintTrace(trace.c_str());
+
+        if (current < sources.size())
+            outputs[current] += line;
+        else
+            header += line;
     }
-    catch (const std::exception& e)
+
+    for (size_t i = 0; i < sources.size(); ++i)
     {
-        cb.PrintString("Error", e.what());
-        if (!trace.empty())
-            cb.PrintString("Output message", trace.c_str());
-        return false;
+        if (found[i])
+        {
+            putBatchTrace(batchKey(sources[i].buffer, sources[i].len,
+                                   *sources[i].stringFile),
+                          std::move(outputs[i]), false);
+        }
     }
-
-    return true;
 }
 
 // Hostboot trace plugin function, see errl::DataPlugin::func_t for more info.
 static bool HBTrace(ErrlUsrParser& cb, void* buffer, uint32_t len,
                     errlver_t /*ver*/, errlsubsec_t sst)
 {
-    if (sst != FIPS_ERRL_UDT_HB_TRACE)
+    TraceSource src;
+    if (!getTraceSource(FIPS_ERRL_COMP_ID, sst, buffer, len, src))
         return false;
-    return fspTrace(cb, reinterpret_cast<const uint8_t*>(buffer), len,
-                    HBStringFile);
+    return fspTrace(cb, src.buffer, src.len, *src.stringFile);
 }
 
 // Hostboot trace plugin registration
@@ -238,21 +444,81 @@ static errl::DataPlugin hbTracePlugin(FIPS_ERRL_COMP_ID, HBTrace, 0);
 static bool OCCTrace(ErrlUsrParser& cb, void* buffer, uint32_t len,
                      errlver_t /*ver*/, errlsubsec_t sst)
 {
-    if (sst != 0 /* OCC trace subtype */)
-        return false;
-
-    // OCC adds a header, just skip it. See OCC src for details.
-    const uint32_t occHdrSize = 0x7c;
-    if (len < occHdrSize)
+    TraceSource src;
+    if (!getTraceSource(OCCC_COMP_ID, sst, buffer, len, src))
         return false;
-
-    return fspTrace(cb, reinterpret_cast<const uint8_t*>(buffer) + occHdrSize,
-                    len - occHdrSize, OCCStringFile);
+    return fspTrace(cb, src.buffer, src.len, *src.stringFile);
 }
 
 // Hostboot trace plugin registration
 static errl::DataPlugin occTracePlugin(OCCC_COMP_ID, OCCTrace, 0);
 
+// Implementation of external interface (see hbplugins.hpp)
+void prefetchUserDefinedSections(const std::vector<UserDefinedData>& sections,
+                                 const TaskRunner& run)
+{
+    {
+        // Buffers of the previous sections may be reused by the new ones
+        std::lock_guard<std::mutex> lock(BatchTracesMutex);
+        BatchTraces.clear();
+    }
+
+    // Natively decoded traces are saved, so they are not decoded twice,
+    // the rest is marked for the utility
+    std::vector<TraceSource> sources;
+    for (const auto& it : sections)
+    {
+        TraceSource src;
+        if (getTraceSource(it.cid, it.sst, it.buffer, it.len, src))
+            sources.push_back(src);
+    }
+    // Not vector<bool>: its elements can't be written from different threads
+    std::vector<char> failed(sources.size(), 0);
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        tasks.emplace_back([&sources, &failed, i]() {
+            const TraceSource& src = sources[i];
+            const TraceStrings* strings = getTraceStrings(*src.stringFile);
+            std::string trace;
+            if (strings && decodeTrace(src.buffer, src.len, *strings, trace))
+            {
+                putBatchTrace(batchKey(src.buffer, src.len, *src.stringFile),
+                              std::move(trace), true);
+            }
+            else
+                failed[i] = 1;
+        });
+    }
+    run(tasks);
+
+    // Traces that can't be decoded natively, grouped by string file
+    std::map<std::string, std::vector<TraceSource>> batches;
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        if (failed[i])
+            batches[*sources[i].stringFile].push_back(sources[i]);
+    }
+
+    // Each string file is handled by its own utility instance
+    std::vector<std::future<void>> runs;
+    for (const auto& it : batches)
+    {
+        runs.emplace_back(std::async(std::launch::async, batchFspTrace,
+                                     std::cref(it.first),
+                                     std::cref(it.second)));
+    }
+    for (auto& it : runs)
+        it.get();
+}
+
+// Implementation of external interface (see hbplugins.hpp)
+std::vector<std::string> getTraceFiles()
+{
+    return {HBStringFile, OCCStringFile, getFspUtilPath()};
+}
+
 // Implementation of external interface (see setup.hpp)
 void setHostbootStrings(const char* stringFile)
 {
@@ -268,7 +534,9 @@ void setOccStrings(const char* stringFile)
 // Implementation of external interface (see setup.hpp)
 void setFspTrace(const char* path)
 {
+    std::lock_guard<std::mutex> lock(FspUtilPathMutex);
     FspUtil = path;
+    FspUtilPath.clear();
 }
 
 } // namespace eSEL
@@ -20,17 +20,69 @@
 
 #include "errlplugins.hpp"
 
+#include <sys/stat.h>
+
+#include <iostream>
+
 namespace eSEL
 {
 
+/**
+ * @struct PluginMessages
+ * @brief Problems reported by the plugin being called.
+ */
+struct PluginMessages
+{
+    std::vector<std::string>& errors;   ///< Failures
+    std::vector<std::string>& warnings; ///< Problems that don't break decoding
+};
+
+/** @brief Messages of the plugin called by the current thread, nullptr
+ *         outside of plugin calls. */
+static thread_local PluginMessages* CurrentMessages = nullptr;
+
 bool parseUserDefinedSection(ErrlUsrParser& cb, uint16_t cid, uint8_t sst,
-                             uint8_t ver, const void* buffer, uint32_t len)
+                             uint8_t ver, const void* buffer, uint32_t len,
+                             std::vector<std::string>& errors,
+                             std::vector<std::string>& warnings)
 {
     const DataPlugins& factory = DataPlugins::instance();
     auto fx = factory.get(cid);
-    if (fx)
-        return fx(cb, const_cast<void*>(buffer), len, ver, sst);
-    return false;
+    if (!fx)
+        return false;
+
+    PluginMessages messages{errors, warnings};
+    PluginMessages* const outer = CurrentMessages;
+    CurrentMessages = &messages;
+    try
+    {
+        const bool rc = fx(cb, const_cast<void*>(buffer), len, ver, sst);
+        CurrentMessages = outer;
+        return rc;
+    }
+    catch (...)
+    {
+        CurrentMessages = outer;
+        throw;
+    }
+}
+
+// Implementation of external interface (see hbplugins.hpp)
+void reportPluginError(const std::string& message)
+{
+    if (CurrentMessages)
+        CurrentMessages->errors.push_back(message);
+    else
+        std::cerr << "Error: " << message << std::endl;
+}
+
+// Implementation of external interface (see hbplugins.hpp)
+void reportPluginWarning(const std::string& message)
+{
+    if (CurrentMessages)
+        CurrentMessages->warnings.push_back(message);
+    else
+        std::cerr << "Warning: " << message << std::endl;
 }
 
 bool getSourceDescription(ErrlUsrParser& cb, uint32_t prRefCode,
@@ -46,4 +98,36 @@ bool getSourceDescription(ErrlUsrParser& cb, uint32_t prRefCode,
     return false;
 }
 
+/**
+ * @brief Append identity of the file: path, size and modification time.
+ *
+ * @param[in,out] identity - identity description to append
+ * @param[in] path - path to the file
+ */
+static void appendFileIdentity(std::string& identity, const std::string& path)
+{
+    identity += path;
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0)
+    {
+        identity += ':';
+        identity += std::to_string(st.st_size);
+        identity += ':';
+        identity += std::to_string(st.st_mtim.tv_sec);
+        identity += '.';
+        identity += std::to_string(st.st_mtim.tv_nsec);
+    }
+    identity += '\n';
+}
+
+// Implementation of external interface (see setup.hpp)
+std::string getSetupIdentity()
+{
+    std::string identity = HOSTBOOT_REVISION "\n";
+    for (const auto& it : getTraceFiles())
+        appendFileIdentity(identity, it);
+    appendFileIdentity(identity, getSymbolsFile());
+    return identity;
+}
+
 } // namespace eSEL
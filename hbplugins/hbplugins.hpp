@@ -18,7 +18,10 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "errlusrparser.H"
 
@@ -34,11 +37,79 @@ namespace eSEL
  * @param[in] ver - section data version
  * @param[in] buffer - source data buffer to parser
  * @param[in] len - length of the buffer in bytes
+ * @param[out] errors - failures reported by the plugin, output is partial
+ * @param[out] warnings - problems reported by the plugin
  *
  * @return true if parsing completed successfully
  */
 bool parseUserDefinedSection(ErrlUsrParser& cb, uint16_t cid, uint8_t sst,
-                             uint8_t ver, const void* buffer, uint32_t len);
+                             uint8_t ver, const void* buffer, uint32_t len,
+                             std::vector<std::string>& errors,
+                             std::vector<std::string>& warnings);
+
+/**
+ * @brief Report failure of the plugin called by parseUserDefinedSection().
+ *        Outside of the plugin call the message is printed to stderr.
+ *
+ * @param[in] message - description of the failure
+ */
+void reportPluginError(const std::string& message);
+
+/**
+ * @brief Report problem found by the plugin called by
+ *        parseUserDefinedSection(), the problem doesn't break decoding.
+ *        Outside of the plugin call the message is printed to stderr.
+ *
+ * @param[in] message - description of the problem
+ */
+void reportPluginWarning(const std::string& message);
+
+/**
+ * @struct UserDefinedData
+ * @brief Raw data of User Defined Data section.
+ */
+struct UserDefinedData
+{
+    uint16_t cid;       ///< Component ID
+    uint8_t sst;        ///< Subsection type ID
+    uint8_t ver;        ///< Section data version
+    const void* buffer; ///< Section data
+    uint32_t len;       ///< Length of the data in bytes
+};
+
+/**
+ * @brief Executor of independent tasks, returns when all of them are done.
+ */
+using TaskRunner = std::function<void(std::vector<std::function<void()>>&)>;
+
+/**
+ * @brief Prepare parsing of multiple User Defined Data sections.
+ *        Traces are decoded natively by tasks passed to the runner, the ones
+ *        that can not be decoded natively are decoded by a single run of the
+ *        external utility. The results are used by parseUserDefinedSection()
+ *        later, sections are matched by buffer address, so the buffers must
+ *        not be changed until parsed. Unused results of the previous call are
+ *        dropped.
+ *
+ * @param[in] sections - sections to prepare
+ * @param[in] run - executor of native decoding tasks
+ */
+void prefetchUserDefinedSections(const std::vector<UserDefinedData>& sections,
+                                 const TaskRunner& run);
+
+/**
+ * @brief Get paths to external files used by trace plugins.
+ *
+ * @return paths to string files and FSP trace utility
+ */
+std::vector<std::string> getTraceFiles();
+
+/**
+ * @brief Get path to HostBoot symbols file.
+ *
+ * @return path to the symbols file
+ */
+std::string getSymbolsFile();
 
 /**
  * @brief Get source description.
@@ -57,8 +128,9 @@ bool getSourceDescription(ErrlUsrParser& cb, uint32_t prRefCode,
  *
  * @param[in] id - component id
  *
- * @return component name, "Undefined [0xXXXX]" if not found
+ * @return component name, "Unknown [0xXXXX]" if not found; the view is
+ *         valid until the end of the program
  */
-std::string getComponentName(uint16_t id);
+std::string_view getComponentName(uint16_t id);
 
 } // namespace eSEL
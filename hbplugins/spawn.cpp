@@ -0,0 +1,281 @@
+/**
+ * @brief Execution of external utilities.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "spawn.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <system_error>
+
+extern char** environ;
+
+namespace eSEL
+{
+
+/** @brief Size of single read from the output pipe. */
+static constexpr size_t ReadChunkSize = 64 * 1024;
+/** @brief Preferred size of the output pipe buffer. */
+static constexpr int PipeSize = 1024 * 1024;
+
+MemFile::MemFile(const char* name) : fd_(-1)
+{
+    const int fd = memfd_create(name, MFD_CLOEXEC);
+    if (fd == -1)
+    {
+        throw std::system_error(errno, std::system_category(),
+                                "Unable to create memory file");
+    }
+
+    // Keep the descriptor out of the range used by the child's standard
+    // streams and input, so it can be duplicated safely
+    fd_ = fcntl(fd, F_DUPFD_CLOEXEC, SpawnInputFd + 1);
+    const int err = errno;
+    ::close(fd);
+    if (fd_ == -1)
+    {
+        throw std::system_error(err, std::system_category(),
+                                "Unable to create memory file");
+    }
+}
+
+MemFile::~MemFile()
+{
+    ::close(fd_);
+}
+
+void MemFile::write(const uint8_t* buffer, size_t len)
+{
+    size_t pos = 0;
+    while (pos < len)
+    {
+        const ssize_t written = ::write(fd_, buffer + pos, len - pos);
+        if (written == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            throw std::system_error(errno, std::system_category(),
+                                    "Unable to write memory file");
+        }
+        pos += written;
+    }
+}
+
+/**
+ * @brief Check if file is executable.
+ *
+ * @param[in] path - path to the file
+ *
+ * @return true if path points to executable regular file
+ */
+static bool isExecutable(const std::string& path)
+{
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode) &&
+           (st.st_mode & (S_IXUSR | S_IXGRP | S_IXOTH));
+}
+
+std::string resolveUtility(const std::string& name)
+{
+    if (name.find('/') != std::string::npos)
+        return name;
+
+    // Current directory
+    char cwd[PATH_MAX];
+    if (getcwd(cwd, sizeof(cwd)))
+    {
+        std::string path = cwd;
+        path += '/';
+        path += name;
+        if (isExecutable(path))
+            return path;
+    }
+
+    // Directories listed in PATH
+    const char* env = getenv("PATH");
+    while (env && *env)
+    {
+        const char* end = env;
+        while (*end && *end != ':')
+            ++end;
+        std::string path(env, end);
+        if (path.empty())
+            path = ".";
+        path += '/';
+        path += name;
+        if (isExecutable(path))
+            return path;
+        env = *end ? end + 1 : end;
+    }
+
+    return name;
+}
+
+/**
+ * @class Pipe
+ * @brief Pipe to read output of the child process.
+ */
+class Pipe
+{
+  public:
+    Pipe()
+    {
+        if (pipe2(fds_, O_CLOEXEC) == -1)
+        {
+            throw std::system_error(errno, std::system_category(),
+                                    "Unable to create pipe");
+        }
+        // Output is read without blocking, the buffer is enlarged to reduce
+        // number of context switches (best effort)
+        fcntl(fds_[0], F_SETFL, O_NONBLOCK);
+        fcntl(fds_[0], F_SETPIPE_SZ, PipeSize);
+    }
+
+    ~Pipe()
+    {
+        closeWrite();
+        ::close(fds_[0]);
+    }
+
+    Pipe(const Pipe&) = delete;
+    Pipe& operator=(const Pipe&) = delete;
+
+    /**
+     * @brief Get descriptor of the write end.
+     *
+     * @return file descriptor
+     */
+    int writeFd() const
+    {
+        return fds_[1];
+    }
+
+    /**
+     * @brief Close write end of the pipe.
+     */
+    void closeWrite()
+    {
+        if (fds_[1] != -1)
+        {
+            ::close(fds_[1]);
+            fds_[1] = -1;
+        }
+    }
+
+    /**
+     * @brief Read all data until the write end is closed by child.
+     *
+     * @param[out] output - buffer to append data
+     */
+    void readAll(std::string& output)
+    {
+        while (true)
+        {
+            const size_t size = output.size();
+            output.resize(size + ReadChunkSize);
+            const ssize_t rc = read(fds_[0], &output[size], ReadChunkSize);
+            output.resize(size + (rc > 0 ? rc : 0));
+            if (rc > 0)
+                continue;
+            if (rc == 0)
+                break; // end of file
+            if (errno == EAGAIN)
+            {
+                pollfd pfd{fds_[0], POLLIN, 0};
+                if (poll(&pfd, 1, -1) != -1 || errno == EINTR)
+                    continue;
+            }
+            else if (errno == EINTR)
+                continue;
+            throw std::system_error(errno, std::system_category(),
+                                    "Unable to read pipe");
+        }
+    }
+
+  private:
+    /** @brief Descriptors: read and write ends. */
+    int fds_[2];
+};
+
+int spawnUtility(const std::string& path, const std::vector<std::string>& args,
+                 const MemFile* input, std::string& output)
+{
+    std::vector<char*> argv;
+    argv.reserve(args.size() + 2);
+    argv.push_back(const_cast<char*>(path.c_str()));
+    for (const auto& it : args)
+        argv.push_back(const_cast<char*>(it.c_str()));
+    argv.push_back(nullptr);
+
+    Pipe pipe;
+
+    // Descriptors are created with close-on-exec flag, so concurrently
+    // spawned processes get only their own ones
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    const int out = pipe.writeFd();
+    posix_spawn_file_actions_adddup2(&actions, out, STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, out, STDERR_FILENO);
+    if (input)
+        posix_spawn_file_actions_adddup2(&actions, input->fd(), SpawnInputFd);
+
+    pid_t pid;
+    const int rc = posix_spawnp(&pid, path.c_str(), &actions, nullptr,
+                                argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (rc)
+    {
+        throw std::system_error(rc, std::system_category(),
+                                "Unable to execute " + path);
+    }
+    pipe.closeWrite();
+
+    try
+    {
+        pipe.readAll(output);
+    }
+    catch (const std::exception&)
+    {
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+        throw;
+    }
+
+    int status;
+    while (waitpid(pid, &status, 0) == -1)
+    {
+        if (errno != EINTR)
+        {
+            throw std::system_error(errno, std::system_category(),
+                                    "Unable to wait for " + path);
+        }
+    }
+
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+}
+
+} // namespace eSEL
@@ -0,0 +1,110 @@
+/**
+ * @brief Execution of external utilities.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace eSEL
+{
+
+/** @brief Descriptor number of the input file inside child process. */
+static constexpr int SpawnInputFd = 3;
+/** @brief Path to the input file inside child process. */
+static constexpr char SpawnInputPath[] = "/proc/self/fd/3";
+
+/**
+ * @class MemFile
+ * @brief Anonymous file in memory, used to pass data to external utility
+ *        without touching the file system.
+ */
+class MemFile
+{
+  public:
+    /**
+     * @brief Constructor: create empty file.
+     *
+     * @param[in] name - name of the file, used for debugging only
+     *
+     * @throws std::system_error if file can not be created
+     */
+    explicit MemFile(const char* name);
+
+    ~MemFile();
+
+    MemFile(const MemFile&) = delete;
+    MemFile& operator=(const MemFile&) = delete;
+
+    /**
+     * @brief Write data to the file.
+     *
+     * @param[in] buffer - source data buffer
+     * @param[in] len - length of the buffer in bytes
+     *
+     * @throws std::system_error in case of errors
+     */
+    void write(const uint8_t* buffer, size_t len);
+
+    /**
+     * @brief Get file descriptor.
+     *
+     * @return file descriptor
+     */
+    int fd() const
+    {
+        return fd_;
+    }
+
+  private:
+    /** @brief File descriptor. */
+    int fd_;
+};
+
+/**
+ * @brief Resolve path to the utility.
+ *        Name without slashes is searched in the current directory first,
+ *        then in PATH.
+ *
+ * @param[in] name - name or path of the utility
+ *
+ * @return path to the executable file, name itself if it was not found
+ */
+std::string resolveUtility(const std::string& name);
+
+/**
+ * @brief Execute external utility and collect its output.
+ *        The utility is started directly, without shell. Standard output and
+ *        error streams are merged.
+ *
+ * @param[in] path - path to the executable file
+ * @param[in] args - arguments, not including the program name
+ * @param[in] input - file passed to the utility as SpawnInputFd, may be
+ *                    nullptr
+ * @param[out] output - output of the utility
+ *
+ * @return exit code of the utility
+ *
+ * @throws std::system_error if utility can not be executed
+ */
+int spawnUtility(const std::string& path, const std::vector<std::string>& args,
+                 const MemFile* input, std::string& output);
+
+} // namespace eSEL
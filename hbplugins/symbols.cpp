@@ -18,11 +18,26 @@
  * limitations under the License.
  */
 
+#include "hbplugins.hpp"
+
 #include <symbols.H>
 
-#include <fstream>
-#include <map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 namespace eSEL
 {
@@ -30,15 +45,161 @@ namespace eSEL
 /**
  * @struct HostbootSymbol
  * @brief Hostboot symbol (function) description.
+ *        The structure is also a record of the binary index file.
  */
 struct HostbootSymbol
 {
+    uint32_t address; ///< Start address of function code
     uint32_t length;  ///< Length of function code
-    std::string func; ///< Function signature
+    uint32_t name;    ///< Offset of function signature in names blob
+};
+
+/* Binary index file format (host byte order):
+SymIndexHeader header
+HostbootSymbol symbols[header.count]  sorted by address
+char names[header.namesSize]          null-terminated function signatures
+*/
+
+/**
+ * @struct SymIndexHeader
+ * @brief Header of the binary index file.
+ */
+struct SymIndexHeader
+{
+    char magic[8];           ///< File magic, see SymIndexMagic
+    uint32_t version;        ///< Format version, see SymIndexVersion
+    uint32_t count;          ///< Number of symbols
+    uint64_t namesSize;      ///< Size of names blob in bytes
+    uint64_t sourceSize;     ///< Size of the symbols file
+    int64_t sourceMtimeSec;  ///< Modification time of the symbols file
+    int64_t sourceMtimeNsec; ///< Nanoseconds part of modification time
+};
+
+/** @brief Magic of the binary index file. */
+static constexpr char SymIndexMagic[sizeof(SymIndexHeader::magic)] = {
+    'E', 'S', 'E', 'L', 'S', 'Y', 'M', 0};
+/** @brief Version of the binary index file format, it doesn't match if the
+ *         file was built on a host with another byte order. */
+static constexpr uint32_t SymIndexVersion = 2;
+/** @brief Suffix of the index file name, appended to the symbols file. */
+static constexpr const char* SymIndexSuffix = ".symidx";
+
+/**
+ * @class MappedFile
+ * @brief Read-only file mapped to memory.
+ */
+class MappedFile
+{
+  public:
+    MappedFile() : data_(nullptr), size_(0)
+    {
+    }
+
+    MappedFile(MappedFile&& other) noexcept :
+        data_(other.data_), size_(other.size_)
+    {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+
+    ~MappedFile()
+    {
+        if (data_)
+            munmap(const_cast<char*>(data_), size_);
+    }
+
+    /**
+     * @brief Map the file.
+     *
+     * @param[in] path - path to the file
+     *
+     * @return false if file can not be mapped
+     */
+    bool open(const char* path)
+    {
+        const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
+            return false;
+        struct stat st;
+        bool rc = fstat(fd, &st) == 0;
+        if (rc && !S_ISREG(st.st_mode))
+        {
+            errno = EINVAL;
+            rc = false;
+        }
+        if (rc && st.st_size)
+        {
+            void* map =
+                mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            rc = map != MAP_FAILED;
+            if (rc)
+            {
+                *this = MappedFile();
+                data_ = static_cast<const char*>(map);
+                size_ = st.st_size;
+            }
+        }
+        const int err = errno;
+        close(fd);
+        errno = err;
+        return rc;
+    }
+
+    const char* data() const
+    {
+        return data_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+  private:
+    /** @brief Mapped data. */
+    const char* data_;
+    /** @brief Size of mapped data. */
+    size_t size_;
+};
+
+/**
+ * @struct SymbolTable
+ * @brief Flat symbols table.
+ *        Symbols are parsed from the text file or mapped from the index.
+ */
+struct SymbolTable
+{
+    /** @brief Symbols sorted by address. */
+    const HostbootSymbol* symbols = nullptr;
+    /** @brief Number of symbols. */
+    size_t count = 0;
+    /** @brief Null-terminated function signatures. */
+    const char* names = nullptr;
+    /** @brief Size of names blob in bytes. */
+    size_t namesSize = 0;
+
+    /** @brief Storage of symbols parsed from the text file. */
+    std::vector<HostbootSymbol> parsedSymbols;
+    /** @brief Storage of names parsed from the text file. */
+    std::vector<char> parsedNames;
+    /** @brief Mapped index file. */
+    MappedFile index;
 };
 
-/** @brief Symbols map: address->description. */
-static std::map<uint32_t, HostbootSymbol> HostbootSymbols;
+/** @brief Symbols table, published with std::atomic_store: lookups don't
+ *         take the mutex and keep their own reference to the table. */
+static std::shared_ptr<const SymbolTable> HostbootSymbols;
+
+/** @brief Mutex to guard symbols loading, sections may be decoded in
+ *         parallel. */
+static std::mutex HostbootSymbolsMutex;
 
 /** @brief Path to the file with symbols list. */
 static std::string HostbootSymbolsFile = DEFAULT_HB_SYMBOLS;
@@ -58,11 +219,328 @@ static constexpr size_t SymLengthPos = 20;
 static constexpr size_t SymLengthLen = 8;
 static constexpr size_t SymSignaturePos = 29;
 
+/** @brief Minimal size of the file part parsed by one thread. */
+static constexpr size_t SymChunkSize = 1024 * 1024;
+
+/**
+ * @brief Parse hex field of the symbol entry.
+ *
+ * @param[in] text - field text
+ * @param[in] len - max length of the field
+ * @param[out] value - parsed value
+ *
+ * @return false if field doesn't start with a hex number
+ */
+static bool parseHexField(const char* text, size_t len, uint32_t& value)
+{
+    return std::from_chars(text, text + len, value, 16).ec == std::errc();
+}
+
+/**
+ * @brief Parse part of the symbols file.
+ *        The part contains all lines that start inside the range.
+ *
+ * @param[in] begin - start of the range, must be a start of a line
+ * @param[in] end - end of the range
+ * @param[in] eof - end of the file
+ * @param[out] table - symbols table to fill
+ *
+ * @return false if the file has invalid format
+ */
+static bool parseSymbols(const char* begin, const char* end, const char* eof,
+                         SymbolTable& table)
+{
+    while (begin < end)
+    {
+        const char* eol =
+            static_cast<const char*>(memchr(begin, '\n', eof - begin));
+        if (!eol)
+            eol = eof;
+        const size_t len = eol - begin;
+
+        // Skip non-function entries, see format description
+        if (len >= SymSignaturePos && *begin == SymFunctionType)
+        {
+            HostbootSymbol sym;
+            if (!parseHexField(begin + SymAddressPos, SymAddressLen,
+                               sym.address) ||
+                !parseHexField(begin + SymLengthPos, SymLengthLen, sym.length))
+                return false;
+            sym.name = static_cast<uint32_t>(table.parsedNames.size());
+            table.parsedSymbols.push_back(sym);
+            table.parsedNames.insert(table.parsedNames.end(),
+                                     begin + SymSignaturePos, eol);
+            table.parsedNames.push_back(0);
+        }
+
+        begin = eol + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Parse symbols file, large files are parsed in parallel.
+ *
+ * @param[in] file - mapped symbols file
+ * @param[out] table - symbols table to fill
+ *
+ * @return false if the file has invalid format
+ */
+static bool parseSymbolsFile(const MappedFile& file, SymbolTable& table)
+{
+    const char* data = file.data();
+    const char* eof = data + file.size();
+
+    // Split the file to chunks aligned to lines
+    const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t chunks = std::min(threads, file.size() / SymChunkSize + 1);
+    const size_t chunkSize = file.size() / chunks;
+    std::vector<const char*> bounds{data};
+    for (size_t i = 1; i < chunks; ++i)
+    {
+        const char* pos = std::max(data + i * chunkSize, bounds.back());
+        const char* eol =
+            static_cast<const char*>(memchr(pos, '\n', eof - pos));
+        bounds.push_back(eol ? eol + 1 : eof);
+    }
+    bounds.push_back(eof);
+
+    std::vector<SymbolTable> parts(chunks);
+    std::vector<std::future<bool>> results;
+    for (size_t i = 1; i < chunks; ++i)
+        results.emplace_back(std::async(std::launch::async, parseSymbols,
+                                        bounds[i], bounds[i + 1], eof,
+                                        std::ref(parts[i])));
+    bool rc = parseSymbols(bounds[0], bounds[1], eof, parts[0]);
+    for (auto& it : results)
+        rc = it.get() && rc;
+    if (!rc)
+        return false;
+
+    // Join parts, order of the file is kept
+    size_t symbols = 0;
+    size_t names = 0;
+    for (const auto& it : parts)
+    {
+        symbols += it.parsedSymbols.size();
+        names += it.parsedNames.size();
+    }
+    std::vector<HostbootSymbol>& allSymbols = table.parsedSymbols;
+    std::vector<char>& allNames = table.parsedNames;
+    allSymbols.reserve(symbols);
+    allNames.reserve(names);
+    for (const auto& it : parts)
+    {
+        const uint32_t offset = static_cast<uint32_t>(allNames.size());
+        for (HostbootSymbol sym : it.parsedSymbols)
+        {
+            sym.name += offset;
+            allSymbols.push_back(sym);
+        }
+        allNames.insert(allNames.end(), it.parsedNames.begin(),
+                        it.parsedNames.end());
+    }
+
+    // Sort by address, the first entry wins for duplicate addresses
+    std::stable_sort(allSymbols.begin(), allSymbols.end(),
+                     [](const HostbootSymbol& lhs, const HostbootSymbol& rhs) {
+                         return lhs.address < rhs.address;
+                     });
+    allSymbols.erase(
+        std::unique(allSymbols.begin(), allSymbols.end(),
+                    [](const HostbootSymbol& lhs, const HostbootSymbol& rhs) {
+                        return lhs.address == rhs.address;
+                    }),
+        allSymbols.end());
+
+    table.symbols = allSymbols.data();
+    table.count = allSymbols.size();
+    table.names = allNames.data();
+    table.namesSize = allNames.size();
+
+    return true;
+}
+
+/**
+ * @brief Use mapped binary index as symbols table.
+ *
+ * @param[in] file - mapped index file
+ * @param[in] source - description of the symbols file to check that the
+ *                     index is up to date, nullptr to skip the check
+ * @param[out] table - symbols table to fill
+ *
+ * @return false if file is not a valid index or it is out of date
+ */
+static bool mapSymbolsIndex(MappedFile&& file, const struct stat* source,
+                            SymbolTable& table)
+{
+    SymIndexHeader hdr;
+    if (file.size() < sizeof(hdr))
+        return false;
+    memcpy(&hdr, file.data(), sizeof(hdr));
+    if (memcmp(hdr.magic, SymIndexMagic, sizeof(hdr.magic)) != 0 ||
+        hdr.version != SymIndexVersion)
+        return false;
+    if (source && (hdr.sourceSize != static_cast<uint64_t>(source->st_size) ||
+                   hdr.sourceMtimeSec != source->st_mtim.tv_sec ||
+                   hdr.sourceMtimeNsec != source->st_mtim.tv_nsec))
+        return false;
+
+    // Check sizes one by one, the sum of header fields can overflow
+    const size_t avail = file.size() - sizeof(hdr);
+    if (hdr.count > avail / sizeof(HostbootSymbol))
+        return false;
+    const size_t symbolsSize = hdr.count * sizeof(HostbootSymbol);
+    if (hdr.namesSize != avail - symbolsSize ||
+        (hdr.namesSize && file.data()[file.size() - 1] != 0))
+        return false;
+
+    const char* symbols = file.data() + sizeof(hdr);
+    const HostbootSymbol* records =
+        reinterpret_cast<const HostbootSymbol*>(symbols);
+
+    // Lookup relies on sorted records, names must be inside the blob
+    for (size_t i = 0; i < hdr.count; ++i)
+    {
+        if (records[i].name >= hdr.namesSize ||
+            (i && records[i - 1].address >= records[i].address))
+            return false;
+    }
+
+    table.symbols = records;
+    table.count = hdr.count;
+    table.names = symbols + symbolsSize;
+    table.namesSize = hdr.namesSize;
+    table.index = std::move(file);
+
+    return true;
+}
+
+/**
+ * @brief Load symbols from text file or from binary index.
+ *
+ * @param[in] path - path to the symbols file or to the index
+ * @param[in] source - description of the symbols file to check that the
+ *                     index is up to date, nullptr to skip the check
+ * @param[out] table - symbols table to fill
+ *
+ * @return false if file can not be loaded
+ */
+static bool loadSymbols(const char* path, const struct stat* source,
+                        SymbolTable& table)
+{
+    MappedFile file;
+    if (!file.open(path))
+        return false;
+    if (file.size() >= sizeof(SymIndexMagic) &&
+        memcmp(file.data(), SymIndexMagic, sizeof(SymIndexMagic)) == 0)
+        return mapSymbolsIndex(std::move(file), source, table);
+    return parseSymbolsFile(file, table);
+}
+
+/**
+ * @brief Load symbols from the prebuilt index of the symbols file.
+ *        The index is used only if it was built from the current version of
+ *        the symbols file, or if the symbols file doesn't exist.
+ *
+ * @param[in] symbolsFile - path to the symbols file
+ * @param[out] table - symbols table to fill
+ *
+ * @return false if there is no valid and up to date index
+ */
+static bool loadSymbolsIndex(const std::string& symbolsFile,
+                             SymbolTable& table)
+{
+    const std::string indexFile = symbolsFile + SymIndexSuffix;
+    struct stat source;
+    const bool hasSource = stat(symbolsFile.c_str(), &source) == 0;
+
+    MappedFile file;
+    if (!file.open(indexFile.c_str()))
+        return false;
+    return mapSymbolsIndex(std::move(file), hasSource ? &source : nullptr,
+                           table);
+}
+
 // Implementation of external interface (see setup.hpp)
 void setHostbootSymbols(const char* symbolsFile)
 {
+    std::lock_guard<std::mutex> lock(HostbootSymbolsMutex);
     HostbootSymbolsFile = symbolsFile;
-    HostbootSymbols.clear();
+    std::atomic_store(&HostbootSymbols, std::shared_ptr<const SymbolTable>());
+}
+
+// Implementation of external interface (see hbplugins.hpp)
+std::string getSymbolsFile()
+{
+    std::lock_guard<std::mutex> lock(HostbootSymbolsMutex);
+    return HostbootSymbolsFile;
+}
+
+// Implementation of external interface (see setup.hpp)
+std::string buildHostbootSymbolsIndex(const char* symbolsFile)
+{
+    // Get file description before reading: if the file is changed while
+    // building, the index is out of date for the new version
+    struct stat source;
+    MappedFile file;
+    if (stat(symbolsFile, &source) != 0 || !file.open(symbolsFile))
+        throw std::system_error(errno, std::system_category(), symbolsFile);
+    SymbolTable table;
+    if (!parseSymbolsFile(file, table))
+        throw std::system_error(EINVAL, std::system_category(), symbolsFile);
+
+    SymIndexHeader hdr;
+    memcpy(hdr.magic, SymIndexMagic, sizeof(hdr.magic));
+    hdr.version = SymIndexVersion;
+    hdr.count = static_cast<uint32_t>(table.count);
+    hdr.namesSize = table.namesSize;
+    hdr.sourceSize = source.st_size;
+    hdr.sourceMtimeSec = source.st_mtim.tv_sec;
+    hdr.sourceMtimeNsec = source.st_mtim.tv_nsec;
+
+    // Write to a temporary file and rename it: other processes may use the
+    // index at the same time
+    const std::string indexFile = std::string(symbolsFile) + SymIndexSuffix;
+    const std::string tmpFile = indexFile + ".tmp." + std::to_string(getpid());
+    const int fd = open(tmpFile.c_str(),
+                        O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd == -1)
+        throw std::system_error(errno, std::system_category(), tmpFile);
+
+    const std::pair<const void*, size_t> parts[] = {
+        {&hdr, sizeof(hdr)},
+        {table.symbols, table.count * sizeof(HostbootSymbol)},
+        {table.names, table.namesSize}};
+    for (const auto& it : parts)
+    {
+        const char* ptr = static_cast<const char*>(it.first);
+        size_t size = it.second;
+        while (size)
+        {
+            const ssize_t rc = write(fd, ptr, size);
+            if (rc == -1 && errno == EINTR)
+                continue;
+            if (rc == -1)
+            {
+                const int err = errno;
+                close(fd);
+                unlink(tmpFile.c_str());
+                throw std::system_error(err, std::system_category(), tmpFile);
+            }
+            ptr += rc;
+            size -= rc;
+        }
+    }
+
+    if (close(fd) != 0 || rename(tmpFile.c_str(), indexFile.c_str()) != 0)
+    {
+        const int err = errno;
+        unlink(tmpFile.c_str());
+        throw std::system_error(err, std::system_category(), indexFile);
+    }
+
+    return indexFile;
 }
 
 } // namespace eSEL
@@ -79,39 +557,33 @@ hbSymbolTable::~hbSymbolTable()
 // Called from hostboot/src/usr/errl/plugins/errludbacktrace.H
 int hbSymbolTable::readSymbols(const char* path)
 {
-    if (!eSEL::HostbootSymbols.empty())
+    std::lock_guard<std::mutex> lock(eSEL::HostbootSymbolsMutex);
+
+    const std::shared_ptr<const eSEL::SymbolTable> loaded =
+        std::atomic_load(&eSEL::HostbootSymbols);
+    if (loaded && loaded->count)
         return 0; // already loaded
 
     if (eSEL::HostbootSymbolsFile.empty())
         eSEL::HostbootSymbolsFile = path;
 
-    try
+    // Prefer prebuilt index, it is used without parsing
+    eSEL::SymbolTable table;
+    if (!eSEL::loadSymbolsIndex(eSEL::HostbootSymbolsFile, table))
     {
-        std::ifstream symFile(eSEL::HostbootSymbolsFile);
-        if (!symFile.good())
-            throw std::exception();
-
-        std::string line;
-        while (std::getline(symFile, line))
+        table = eSEL::SymbolTable();
+        if (!eSEL::loadSymbols(eSEL::HostbootSymbolsFile.c_str(), nullptr,
+                               table))
         {
-            if (line.length() < eSEL::SymSignaturePos ||
-                line[0] != eSEL::SymFunctionType)
-                continue; // skip non-function entries, see format description
-
-            const uint32_t addr = std::stoul(
-                line.substr(eSEL::SymAddressPos, eSEL::SymAddressLen), 0, 16);
-            const uint32_t len = std::stoul(
-                line.substr(eSEL::SymLengthPos, eSEL::SymLengthLen), 0, 16);
-            const std::string func = line.substr(eSEL::SymSignaturePos);
-
-            eSEL::HostbootSymbols.emplace(
-                std::make_pair(addr, eSEL::HostbootSymbol{len, func}));
+            eSEL::reportPluginWarning("Unable to load symbols file " +
+                                      eSEL::HostbootSymbolsFile);
+            return -1;
         }
     }
-    catch (const std::exception&)
-    {
-        return -1;
-    }
+    std::atomic_store(&eSEL::HostbootSymbols,
+                      std::shared_ptr<const eSEL::SymbolTable>(
+                          std::make_shared<eSEL::SymbolTable>(
+                              std::move(table))));
 
     return 0;
 }
@@ -120,13 +592,26 @@ int hbSymbolTable::readSymbols(const char* path)
 // Called from hostboot/src/usr/errl/plugins/errludbacktrace.H
 char* hbSymbolTable::nearestSymbol(uint64_t address)
 {
-    auto it = eSEL::HostbootSymbols.lower_bound(address);
-    if (it != eSEL::HostbootSymbols.end())
+    // The returned name points into the table, so keep the table referenced
+    // until the next lookup made by this thread
+    thread_local std::shared_ptr<const eSEL::SymbolTable> current;
+    current = std::atomic_load(&eSEL::HostbootSymbols);
+    if (!current)
+        return nullptr;
+    const eSEL::SymbolTable& table = *current;
+    const eSEL::HostbootSymbol* end = table.symbols + table.count;
+    // The first symbol with start address greater than requested
+    const eSEL::HostbootSymbol* it = std::upper_bound(
+        table.symbols, end, address,
+        [](uint64_t addr, const eSEL::HostbootSymbol& sym) {
+            return addr < sym.address;
+        });
+    if (it != table.symbols)
     {
-        if (address != it->first && it != eSEL::HostbootSymbols.begin())
-            --it; // move to the nearest entry
-        if (address < it->first + it->second.length)
-            return const_cast<char*>(it->second.func.c_str());
+        --it; // nearest symbol at or below the address
+        if (address < static_cast<uint64_t>(it->address) + it->length &&
+            it->name < table.namesSize)
+            return const_cast<char*>(table.names + it->name);
     }
     return nullptr;
 }
@@ -0,0 +1,628 @@
+/**
+ * @brief Decoder of HostBoot/OCC binary trace buffers (fsp-trace format).
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "trace_decoder.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+namespace eSEL
+{
+
+/* Trace buffer format (byte order is defined by the header):
+Header (trace_buf_head_t):
+  uint8_t  ver         version of the header
+  uint8_t  hdr_len     size of the header in bytes
+  uint8_t  time_flg    meaning of timestamps
+  uint8_t  endian_flg  byte order: 'B' or 'L'
+  char     comp[16]    buffer (component) name
+  uint32_t size        size of the buffer including header
+  uint32_t times_wrap  number of buffer wraps
+  uint32_t next_free   offset of the byte behind the latest entry
+  uint32_t te_count    number of entries
+  uint32_t extracted   not used
+Entries, each one is:
+  uint32_t tbh, tbl    timestamp
+  uint32_t tid         thread id
+  uint16_t length      size of entry data
+  uint16_t tag         type of entry
+  uint32_t hash        hash of format string
+  uint32_t line        source line number
+  uint8_t  data[]      arguments (4-bytes aligned), binary data for dumps
+  uint32_t size        size of the entry without this field
+*/
+// Format specific constants
+static constexpr size_t TraceHeaderSize = 40;
+static constexpr size_t TraceCompPos = 4;
+static constexpr size_t TraceCompLen = 16;
+static constexpr size_t TraceSizePos = 20;
+static constexpr size_t TraceWrapPos = 24;
+static constexpr size_t TraceNextFreePos = 28;
+static constexpr size_t TraceEntryHeadSize = 24;
+static constexpr size_t TraceEntrySizeLen = 4;
+
+/** @brief Entry tags: traces and binary dumps. */
+static constexpr uint16_t TraceTagFieldTrace = 0x4654; // "FT"
+static constexpr uint16_t TraceTagFieldBin = 0x4644;   // "FD"
+static constexpr uint16_t TraceTagDebugTrace = 0x4454; // "DT"
+static constexpr uint16_t TraceTagDebugBin = 0x4442;   // "DB"
+static constexpr uint16_t TraceTagCompTrace = 0x434f;  // "CO"
+
+/** @brief Timestamp types. */
+enum TraceTime
+{
+    TraceTimeReal = 0,     ///< Seconds and microseconds
+    TraceTime50MHz = 1,    ///< Ticks of 50MHz timer
+    TraceTime200MHz = 2,   ///< Ticks of 200MHz timer
+    TraceTime167MHz = 3,   ///< Ticks of 166.666MHz timer
+    TraceTimeTimespec = 4, ///< Seconds and nanoseconds
+};
+
+/** @brief Number of bytes printed in a line of binary dump. */
+static constexpr size_t TraceDumpLine = 16;
+
+/**
+ * @class TraceData
+ * @brief Reader of trace buffer fields.
+ */
+class TraceData
+{
+  public:
+    TraceData(const uint8_t* data, size_t size, bool littleEndian) :
+        data_(data), size_(size), little_(littleEndian)
+    {
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    const uint8_t* data(size_t offset) const
+    {
+        return data_ + offset;
+    }
+
+    uint64_t read(size_t offset, size_t len) const
+    {
+        uint64_t val = 0;
+        for (size_t i = 0; i < len; ++i)
+        {
+            const size_t pos = little_ ? len - i - 1 : i;
+            val = (val << 8) | data_[offset + pos];
+        }
+        return val;
+    }
+
+    uint16_t u16(size_t offset) const
+    {
+        return static_cast<uint16_t>(read(offset, sizeof(uint16_t)));
+    }
+
+    uint32_t u32(size_t offset) const
+    {
+        return static_cast<uint32_t>(read(offset, sizeof(uint32_t)));
+    }
+
+  private:
+    const uint8_t* data_;
+    size_t size_;
+    bool little_;
+};
+
+/**
+ * @struct TraceEntry
+ * @brief Decoded trace entry.
+ */
+struct TraceEntry
+{
+    uint32_t sec;          ///< Timestamp: seconds
+    uint32_t usec;         ///< Timestamp: microseconds
+    uint32_t tid;          ///< Thread ID
+    std::string_view comp; ///< Buffer name
+    std::string text;      ///< Formatted text
+};
+
+/**
+ * @brief Align size to 4 bytes (size of trace argument).
+ *
+ * @param[in] size - size to align
+ *
+ * @return aligned size
+ */
+static inline size_t align4(size_t size)
+{
+    return (size + 3) & ~static_cast<size_t>(3);
+}
+
+TraceStrings::TraceStrings(const char* path)
+{
+    std::ifstream file(path);
+    if (!file.good())
+        throw std::system_error(errno, std::system_category(), path);
+    std::ostringstream buf;
+    buf << file.rdbuf();
+    content_ = buf.str();
+
+    /* String file format:
+    #FSP_TRACE_v2|||Build date|||BUILD:/path/to/build
+    hash||format||source file
+    */
+    static constexpr std::string_view Separator = "||";
+    std::string_view text = content_;
+    while (!text.empty())
+    {
+        const size_t eol = std::min(text.find('\n'), text.size());
+        const std::string_view line = text.substr(0, eol);
+        text.remove_prefix(std::min(eol + 1, text.size()));
+
+        const size_t fmtPos = line.find(Separator);
+        const size_t filePos = line.rfind(Separator);
+        if (line.empty() || line[0] == '#' ||
+            fmtPos == std::string_view::npos || filePos == fmtPos)
+            continue;
+
+        uint32_t hash;
+        const char* hashEnd = line.data() + fmtPos;
+        const auto rc = std::from_chars(line.data(), hashEnd, hash);
+        if (rc.ec != std::errc() || rc.ptr != hashEnd)
+            continue;
+
+        const size_t fmtStart = fmtPos + Separator.size();
+        // The first entry wins for duplicate hashes
+        index_.emplace(hash,
+                       Entry{line.substr(fmtStart, filePos - fmtStart),
+                             line.substr(filePos + Separator.size())});
+    }
+}
+
+const TraceStrings::Entry* TraceStrings::find(uint32_t hash) const
+{
+    const auto it = index_.find(hash);
+    return it != index_.end() ? &it->second : nullptr;
+}
+
+/**
+ * @brief Print single argument using conversion specification.
+ *
+ * @param[out] text - output buffer
+ * @param[in] size - size of the output buffer
+ * @param[in] spec - conversion specification
+ * @param[in] star - values of width and precision given as arguments ('*')
+ * @param[in] stars - number of width and precision arguments
+ * @param[in] arg - argument to print
+ *
+ * @return snprintf return code
+ */
+template <typename T>
+static int printArg(char* text, size_t size, const std::string& spec,
+                    const int* star, size_t stars, T arg)
+{
+    switch (stars)
+    {
+        case 2:
+            return snprintf(text, size, spec.c_str(), star[0], star[1], arg);
+        case 1:
+            return snprintf(text, size, spec.c_str(), star[0], arg);
+        default:
+            return snprintf(text, size, spec.c_str(), arg);
+    }
+}
+
+/**
+ * @brief Format entry's text using printf-like format string.
+ *
+ * @param[in] buf - trace buffer
+ * @param[in] offset - offset of entry's arguments
+ * @param[in] len - size of entry's arguments in bytes
+ * @param[in] format - format string
+ * @param[out] out - output text
+ *
+ * @return false if format is not supported or doesn't match arguments
+ */
+static bool formatEntry(const TraceData& buf, size_t offset, size_t len,
+                        std::string_view format, std::string& out)
+{
+    const size_t end = offset + len;
+    size_t pos = offset;
+
+    // Get next numeric argument
+    const auto nextArg = [&](size_t size, uint64_t& val) {
+        if (pos + size > end)
+            return false;
+        val = buf.read(pos, size);
+        pos += size;
+        return true;
+    };
+
+    for (size_t i = 0; i < format.size(); ++i)
+    {
+        if (format[i] != '%')
+        {
+            out += format[i];
+            continue;
+        }
+
+        // Parse conversion specification: %[flags][width][.precision]
+        // [length]type, length is replaced with size of the argument
+        std::string spec = "%";
+        int star[2];
+        size_t stars = 0;
+        ++i;
+        while (i < format.size() && strchr("-+ #0", format[i]))
+            spec += format[i++];
+        for (int part = 0; part < 2; ++part)
+        {
+            if (part && i < format.size() && format[i] == '.')
+                spec += format[i++];
+            if (i < format.size() && format[i] == '*')
+            {
+                uint64_t val;
+                if (!nextArg(sizeof(uint32_t), val))
+                    return false;
+                star[stars++] = static_cast<int32_t>(val);
+                spec += format[i++];
+            }
+            while (i < format.size() &&
+                   isdigit(static_cast<unsigned char>(format[i])))
+                spec += format[i++];
+        }
+        size_t argSize = sizeof(uint32_t);
+        while (i < format.size() && strchr("hlLqjzt", format[i]))
+        {
+            if (format[i] == 'L' || format[i] == 'q' || format[i] == 'j' ||
+                (format[i] == 'l' && i + 1 < format.size() &&
+                 format[i + 1] == 'l'))
+                argSize = sizeof(uint64_t);
+            ++i;
+        }
+        if (i >= format.size())
+            return false;
+
+        const char type = format[i];
+        char text[128];
+        int rc;
+        if (type == '%')
+        {
+            out += '%';
+            continue;
+        }
+        else if (type == 's')
+        {
+            if (pos >= end)
+                return false;
+            const char* str = reinterpret_cast<const char*>(buf.data(pos));
+            const size_t strLen = strnlen(str, end - pos);
+            if (pos + strLen == end)
+                return false; // not null-terminated
+            const std::string arg(str, strLen);
+            pos += align4(strLen + 1);
+            rc = printArg(text, sizeof(text), spec + 's', star, stars,
+                          arg.c_str());
+            if (rc >= static_cast<int>(sizeof(text)))
+            {
+                // Long string, print as is
+                out += arg;
+                continue;
+            }
+        }
+        else if (strchr("diouxXc", type))
+        {
+            uint64_t val;
+            if (!nextArg(argSize, val))
+                return false;
+            long long arg;
+            if (argSize == sizeof(uint64_t))
+                arg = static_cast<long long>(val);
+            else if (type == 'd' || type == 'i' || type == 'c')
+                arg = static_cast<int32_t>(val);
+            else
+                arg = static_cast<uint32_t>(val);
+            if (type == 'c')
+                rc = printArg(text, sizeof(text), spec + type, star, stars,
+                              static_cast<int>(arg));
+            else
+                rc = printArg(text, sizeof(text), spec + "ll" + type, star,
+                              stars, arg);
+        }
+        else
+        {
+            return false; // floating point, pointers etc are not supported
+        }
+
+        if (rc < 0 || rc >= static_cast<int>(sizeof(text)))
+            return false;
+        out.append(text, rc);
+    }
+
+    // All arguments must be consumed
+    return align4(pos - offset) == align4(len);
+}
+
+/**
+ * @brief Append hex dump of binary entry's data.
+ *
+ * @param[in] data - data to dump
+ * @param[in] len - size of data in bytes
+ * @param[out] out - output text
+ */
+static void dumpEntry(const uint8_t* data, size_t len, std::string& out)
+{
+    for (size_t line = 0; line < len; line += TraceDumpLine)
+    {
+        char text[32];
+        snprintf(text, sizeof(text), "\n   ~[0x%04zx]", line);
+        out += text;
+        for (size_t i = line; i < line + TraceDumpLine; ++i)
+        {
+            if (i % sizeof(uint32_t) == 0)
+                out += ' ';
+            if (i < len)
+            {
+                snprintf(text, sizeof(text), "%02x", data[i]);
+                out += text;
+            }
+            else
+                out += "  ";
+        }
+        out += "   *";
+        for (size_t i = line; i < std::min(len, line + TraceDumpLine); ++i)
+            out += isprint(data[i]) ? static_cast<char>(data[i]) : '.';
+        out += '*';
+    }
+}
+
+/**
+ * @brief Convert entry's timestamp to seconds and microseconds.
+ *
+ * @param[in] timeFlag - timestamp type
+ * @param[in] tbh - upper part of timestamp
+ * @param[in] tbl - lower part of timestamp
+ * @param[out] entry - entry to fill
+ *
+ * @return false if timestamp type is not supported
+ */
+static bool convertTime(uint8_t timeFlag, uint32_t tbh, uint32_t tbl,
+                        TraceEntry& entry)
+{
+    const uint64_t ticks = (static_cast<uint64_t>(tbh) << 32) | tbl;
+    uint64_t freq;
+    switch (timeFlag)
+    {
+        case TraceTimeReal:
+            entry.sec = tbh;
+            entry.usec = tbl;
+            return true;
+        case TraceTimeTimespec:
+            entry.sec = tbh;
+            entry.usec = tbl / 1000;
+            return true;
+        case TraceTime50MHz:
+            freq = 50000000;
+            break;
+        case TraceTime200MHz:
+            freq = 200000000;
+            break;
+        case TraceTime167MHz:
+            freq = 166666667;
+            break;
+        default:
+            return false;
+    }
+    entry.sec = static_cast<uint32_t>(ticks / freq);
+    entry.usec = static_cast<uint32_t>((ticks % freq) * 1000000 / freq);
+    return true;
+}
+
+/**
+ * @brief Decode entries of trace buffer walking from the latest entry to the
+ *        oldest one.
+ *
+ * @param[in] buf - trace buffer
+ * @param[in] strings - table of format strings
+ * @param[in] pos - end of the latest entry
+ * @param[in] bound - lowest position of entries
+ * @param[out] entries - decoded entries, appended in reverse order
+ *
+ * @return position where the walk stopped, std::string::npos if buffer has
+ *         unsupported format
+ */
+static size_t walkEntries(const TraceData& buf, const TraceStrings& strings,
+                          size_t pos, size_t bound,
+                          std::vector<TraceEntry>& entries)
+{
+    constexpr size_t failed = std::string::npos;
+
+    const uint8_t timeFlag = *buf.data(2);
+    const char* compName =
+        reinterpret_cast<const char*>(buf.data(TraceCompPos));
+    const std::string_view comp(compName, strnlen(compName, TraceCompLen));
+
+    while (pos >= bound + TraceEntryHeadSize + TraceEntrySizeLen)
+    {
+        const size_t size = buf.u32(pos - TraceEntrySizeLen);
+        if (size < TraceEntryHeadSize ||
+            size > pos - TraceEntrySizeLen - bound)
+            break;
+        const size_t start = pos - TraceEntrySizeLen - size;
+        const size_t dataLen = buf.u16(start + 12);
+        if (TraceEntryHeadSize + dataLen > size)
+            return failed;
+
+        TraceEntry entry;
+        if (!convertTime(timeFlag, buf.u32(start), buf.u32(start + 4), entry))
+            return failed;
+        entry.tid = buf.u32(start + 8);
+        entry.comp = comp;
+
+        const uint16_t tag = buf.u16(start + 14);
+        const TraceStrings::Entry* fmt = strings.find(buf.u32(start + 16));
+        if (!fmt)
+            return failed;
+        const uint32_t line = buf.u32(start + 20);
+        char source[32];
+        snprintf(source, sizeof(source), "(%u)|", line);
+        entry.text.assign(fmt->file.data(), fmt->file.size());
+        entry.text += source;
+
+        const size_t dataPos = start + TraceEntryHeadSize;
+        if (tag == TraceTagFieldBin || tag == TraceTagDebugBin)
+        {
+            entry.text.append(fmt->format.data(), fmt->format.size());
+            dumpEntry(buf.data(dataPos), dataLen, entry.text);
+        }
+        else if (tag == TraceTagFieldTrace || tag == TraceTagDebugTrace ||
+                 tag == TraceTagCompTrace)
+        {
+            if (!formatEntry(buf, dataPos, dataLen, fmt->format, entry.text))
+                return failed;
+        }
+        else
+            return failed;
+
+        entries.emplace_back(std::move(entry));
+        pos = start;
+    }
+
+    return pos;
+}
+
+/**
+ * @brief Decode single trace buffer.
+ *
+ * @param[in] buf - trace buffer
+ * @param[in] strings - table of format strings
+ * @param[out] entries - decoded entries
+ *
+ * @return false if buffer has unsupported format
+ */
+static bool decodeBuffer(const TraceData& buf, const TraceStrings& strings,
+                         std::vector<TraceEntry>& entries)
+{
+    const size_t hdrLen = *buf.data(1);
+    const size_t nextFree = buf.u32(TraceNextFreePos);
+    const bool wrapped = buf.u32(TraceWrapPos) != 0;
+    if (hdrLen < TraceHeaderSize || nextFree < hdrLen || nextFree > buf.size())
+        return false;
+
+    // Entries written after the last wrap are placed between the header and
+    // the next free position, the part must be walked entirely
+    const size_t first = entries.size();
+    if (walkEntries(buf, strings, nextFree, hdrLen, entries) != hdrLen)
+        return false;
+
+    if (wrapped)
+    {
+        // Older entries are placed between the next free position and the
+        // end of the buffer, the oldest of them may be partially
+        // overwritten. If the latest of them can't be found, the layout is
+        // unknown and the buffer is left for FSP trace utility.
+        const size_t end = buf.size();
+        const size_t pos = walkEntries(buf, strings, end, nextFree, entries);
+        if (pos == std::string::npos ||
+            (pos == end &&
+             end - nextFree >= TraceEntryHeadSize + TraceEntrySizeLen))
+            return false;
+    }
+
+    std::reverse(entries.begin() + first, entries.end());
+    return true;
+}
+
+bool decodeTrace(const uint8_t* data, size_t len, const TraceStrings& strings,
+                 std::string& out)
+{
+    std::vector<TraceEntry> entries;
+
+    size_t pos = 0;
+    while (pos < len)
+    {
+        if (len - pos < TraceHeaderSize)
+            return false;
+        const bool little = data[pos + 3] == 'L';
+        const TraceData hdr(data + pos, TraceHeaderSize, little);
+        const size_t size = hdr.u32(TraceSizePos);
+        if (size < TraceHeaderSize || size > len - pos)
+            return false;
+        if (!decodeBuffer(TraceData(data + pos, size, little), strings,
+                          entries))
+            return false;
+        pos += size;
+    }
+
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const TraceEntry& lhs, const TraceEntry& rhs) {
+                         return lhs.sec < rhs.sec ||
+                                (lhs.sec == rhs.sec && lhs.usec < rhs.usec);
+                     });
+
+    out += "-------------------------------------------------------------------"
+           "------------\n";
+    out += "       Sec.Usec|  TID|Component       |File(Line)|Entry Data\n";
+    out += "-------------------------------------------------------------------"
+           "------------\n";
+    for (const auto& it : entries)
+    {
+        char prefix[64];
+        snprintf(prefix, sizeof(prefix), "%8u.%06u|%5u|%-16.*s|", it.sec,
+                 it.usec, it.tid, static_cast<int>(it.comp.size()),
+                 it.comp.data());
+        out += prefix;
+        out += it.text;
+        out += '\n';
+    }
+
+    return true;
+}
+
+bool renameTraceBuffers(
+    uint8_t* data, size_t len,
+    const std::function<std::string(std::string_view)>& rename)
+{
+    size_t pos = 0;
+    while (pos < len)
+    {
+        if (len - pos < TraceHeaderSize)
+            return false;
+        const TraceData hdr(data + pos, TraceHeaderSize, data[pos + 3] == 'L');
+        const size_t size = hdr.u32(TraceSizePos);
+        if (size < TraceHeaderSize || size > len - pos)
+            return false;
+
+        char* comp = reinterpret_cast<char*>(data + pos + TraceCompPos);
+        const std::string name =
+            rename(std::string_view(comp, strnlen(comp, TraceCompLen)));
+        if (name.size() > TraceCompLen)
+            return false;
+        memset(comp, 0, TraceCompLen);
+        memcpy(comp, name.data(), name.size());
+
+        pos += size;
+    }
+    return true;
+}
+
+} // namespace eSEL
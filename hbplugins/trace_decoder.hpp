@@ -0,0 +1,107 @@
+/**
+ * @brief Decoder of HostBoot/OCC binary trace buffers (fsp-trace format).
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace eSEL
+{
+
+/**
+ * @class TraceStrings
+ * @brief Table of trace format strings (hbotStringFile, occStringFile).
+ */
+class TraceStrings
+{
+  public:
+    /**
+     * @struct Entry
+     * @brief Format string description.
+     */
+    struct Entry
+    {
+        std::string_view format; ///< Format string (printf-like)
+        std::string_view file;   ///< Source file name
+    };
+
+    /**
+     * @brief Constructor: load string file.
+     *
+     * @param[in] path - path to the string file
+     *
+     * @throws std::system_error if file can not be read
+     */
+    explicit TraceStrings(const char* path);
+
+    TraceStrings(const TraceStrings&) = delete;
+    TraceStrings& operator=(const TraceStrings&) = delete;
+
+    /**
+     * @brief Find format string by its hash.
+     *
+     * @param[in] hash - hash value
+     *
+     * @return pointer to the entry or nullptr if hash is unknown
+     */
+    const Entry* find(uint32_t hash) const;
+
+  private:
+    /** @brief Content of the string file. */
+    std::string content_;
+    /** @brief Index: hash -> entry, views refer to the content. */
+    std::unordered_map<uint32_t, Entry> index_;
+};
+
+/**
+ * @brief Decode binary trace buffers to text.
+ *        Data may contain several buffers, entries of all buffers are
+ *        printed in chronological order.
+ *
+ * @param[in] data - trace data
+ * @param[in] len - length of the data in bytes
+ * @param[in] strings - table of format strings
+ * @param[out] out - decoded text
+ *
+ * @return false if data has an unsupported format or refers to an unknown
+ *         format string, the output is incomplete in this case
+ */
+bool decodeTrace(const uint8_t* data, size_t len, const TraceStrings& strings,
+                 std::string& out);
+
+/**
+ * @brief Replace names of all buffers in trace data.
+ *
+ * @param[in,out] data - trace data
+ * @param[in] len - length of the data in bytes
+ * @param[in] rename - function that gets original name of the buffer and
+ *                     returns the new one (up to 16 characters)
+ *
+ * @return false if data is not a sequence of trace buffers, the data may be
+ *         partially modified in this case
+ */
+bool renameTraceBuffers(
+    uint8_t* data, size_t len,
+    const std::function<std::string(std::string_view)>& rename);
+
+} // namespace eSEL
@@ -0,0 +1,123 @@
+/**
+ * @brief Non-owning view of a raw data buffer.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace eSEL
+{
+
+/**
+ * @class ByteSpan
+ * @brief Non-owning view of a constant byte buffer.
+ *        Subset of std::span<const uint8_t> available in C++17.
+ */
+class ByteSpan
+{
+  public:
+    /**
+     * @brief Constructor for empty view.
+     */
+    constexpr ByteSpan() noexcept : data_(nullptr), size_(0)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] data - pointer to the data buffer
+     * @param[in] size - size of the data buffer in bytes
+     */
+    constexpr ByteSpan(const uint8_t* data, size_t size) noexcept :
+        data_(data), size_(size)
+    {
+    }
+
+    /**
+     * @brief Get pointer to the first byte.
+     *
+     * @return pointer to the data buffer
+     */
+    constexpr const uint8_t* data() const noexcept
+    {
+        return data_;
+    }
+
+    /**
+     * @brief Get size of the view.
+     *
+     * @return size of the view in bytes
+     */
+    constexpr size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Check if view is empty.
+     *
+     * @return true if view is empty
+     */
+    constexpr bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    constexpr const uint8_t* begin() const noexcept
+    {
+        return data_;
+    }
+
+    constexpr const uint8_t* end() const noexcept
+    {
+        return data_ + size_;
+    }
+
+    constexpr const uint8_t& operator[](size_t idx) const noexcept
+    {
+        return data_[idx];
+    }
+
+    /**
+     * @brief Get part of the view.
+     *
+     * @param[in] offset - offset of the first byte
+     * @param[in] count - number of bytes, the rest of view if out of range
+     *
+     * @return view of the part
+     */
+    constexpr ByteSpan subspan(size_t offset, size_t count = SIZE_MAX) const
+        noexcept
+    {
+        if (offset > size_)
+            offset = size_;
+        if (count > size_ - offset)
+            count = size_ - offset;
+        return ByteSpan(data_ + offset, count);
+    }
+
+  private:
+    /** @brief Pointer to the data buffer. */
+    const uint8_t* data_;
+    /** @brief Size of the data buffer in bytes. */
+    size_t size_;
+};
+
+} // namespace eSEL
@@ -0,0 +1,106 @@
+/**
+ * @brief eSEL with value-semantic storage of sections.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "compact_event.hpp"
+
+#include "walker.hpp"
+
+namespace eSEL
+{
+
+CompactEvent::CompactEvent()
+{
+}
+
+void CompactEvent::parse(const uint8_t* data, size_t len)
+{
+    throwOnError(tryParse(data, len));
+}
+
+ParseStatus CompactEvent::tryParse(const uint8_t* data, size_t len) noexcept
+{
+    /** @brief Sink for section walker: creates typed sections. */
+    struct Sink
+    {
+        void reserve(size_t count)
+        {
+            event.sections_.reserve(count);
+        }
+        ParseError append(const SectionView& section)
+        {
+            if (!checkPayloadSize(section.header))
+                return ParseError::PayloadSize;
+            event.append(section.header,
+                         Section::Payload(section.payload.begin(),
+                                          section.payload.end()));
+            return ParseError::None;
+        }
+        CompactEvent& event;
+    } sink{*this};
+
+    try
+    {
+        size_t length = 0;
+        return walkEvent(data, len, selRecord_, length, sink);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return {ParseError::OutOfMemory, 0};
+    }
+}
+
+const SectionValues& CompactEvent::getSections() const
+{
+    return sections_;
+}
+
+std::optional<SelRecord> CompactEvent::getSelRecord() const
+{
+    return selRecord_;
+}
+
+void CompactEvent::append(const Section::Header& header,
+                          Section::Payload&& payload)
+{
+    switch (header.id)
+    {
+        case SectionPH::SectionId:
+            sections_.emplace_back(std::in_place_type<SectionPH>, header,
+                                   std::move(payload));
+            break;
+        case SectionPS::SectionId:
+            sections_.emplace_back(std::in_place_type<SectionPS>, header,
+                                   std::move(payload));
+            break;
+        case SectionUH::SectionId:
+            sections_.emplace_back(std::in_place_type<SectionUH>, header,
+                                   std::move(payload));
+            break;
+        case SectionUD::SectionId:
+            sections_.emplace_back(std::in_place_type<SectionUD>, header,
+                                   std::move(payload));
+            break;
+        default:
+            sections_.emplace_back(std::in_place_type<Section>, header,
+                                   std::move(payload));
+    }
+
+    byType_[sections_.back().index()].push_back(sections_.size() - 1);
+}
+
+} // namespace eSEL
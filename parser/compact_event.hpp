@@ -0,0 +1,170 @@
+/**
+ * @brief eSEL with value-semantic storage of sections.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "fmtexcept.hpp"
+#include "parse_status.hpp"
+#include "section_ph.hpp"
+#include "section_ps.hpp"
+#include "section_ud.hpp"
+#include "section_uh.hpp"
+#include "sel_record.hpp"
+
+#include <array>
+#include <optional>
+#include <variant>
+#include <vector>
+
+namespace eSEL
+{
+
+/** @brief Typed section, the last alternative is used for unknown types. */
+using SectionValue =
+    std::variant<SectionPH, SectionPS, SectionUH, SectionUD, Section>;
+
+/** @brief Contiguous array of typed sections. */
+using SectionValues = std::vector<SectionValue>;
+
+/**
+ * @brief Get base interface of typed section.
+ *
+ * @param[in] section - typed section
+ *
+ * @return base section interface
+ */
+inline const Section& asSection(const SectionValue& section)
+{
+    return std::visit([](const auto& s) -> const Section& { return s; },
+                      section);
+}
+
+/**
+ * @class CompactEvent
+ * @brief OpenPOWER Platform Event Log record, aka eSEL.
+ *        Unlike Event, sections are stored by value in a contiguous array
+ *        and can be searched by type in constant time.
+ */
+class CompactEvent
+{
+  public:
+    CompactEvent();
+
+    /**
+     * @brief Parse eSEL from raw binary data.
+     *
+     * @param[in] data - pointer to the data buffer
+     * @param[in] len - size of the data buffer in bytes
+     *
+     * @throws InvalidFormat in case of errors
+     */
+    void parse(const uint8_t* data, size_t len);
+
+    /**
+     * @brief Parse eSEL from raw binary data without exceptions.
+     *        In case of errors, the event keeps the sections parsed before
+     *        the error.
+     *
+     * @param[in] data - pointer to the data buffer
+     * @param[in] len - size of the data buffer in bytes
+     *
+     * @return parsing status
+     */
+    ParseStatus tryParse(const uint8_t* data, size_t len) noexcept;
+
+    /**
+     * @brief Get sections array.
+     *
+     * @return array of event's sections
+     */
+    const SectionValues& getSections() const;
+
+    /**
+     * @brief Get SEL record.
+     *
+     * @return SEL record instance or std::nullopt if event doesn't contain one
+     */
+    std::optional<SelRecord> getSelRecord() const;
+
+    /**
+     * @brief Find the first section of specified type.
+     *        Use Section type to find the first section of unknown type.
+     *
+     * @return pointer to the section or nullptr if not found
+     */
+    template <typename T>
+    const T* find() const
+    {
+        constexpr size_t type = typeIndex<T>();
+        const std::vector<size_t>& idx = byType_[type];
+        return idx.empty() ? nullptr : &std::get<type>(sections_[idx.front()]);
+    }
+
+    /**
+     * @brief Find all sections of specified type.
+     *        Use Section type to find sections of unknown types.
+     *
+     * @return array of pointers to the sections in the event order
+     */
+    template <typename T>
+    std::vector<const T*> findAll() const
+    {
+        constexpr size_t type = typeIndex<T>();
+        std::vector<const T*> found;
+        found.reserve(byType_[type].size());
+        for (size_t idx : byType_[type])
+            found.push_back(&std::get<type>(sections_[idx]));
+        return found;
+    }
+
+  private:
+    /**
+     * @brief Get index of the type in the SectionValue variant.
+     *
+     * @return index of the type
+     */
+    template <typename T, size_t I = 0>
+    static constexpr size_t typeIndex()
+    {
+        static_assert(I < std::variant_size_v<SectionValue>,
+                      "Unsupported section type");
+        if constexpr (std::is_same_v<
+                          T, std::variant_alternative_t<I, SectionValue>>)
+            return I;
+        else
+            return typeIndex<T, I + 1>();
+    }
+
+    /**
+     * @brief Append typed section.
+     *
+     * @param[in] header - section header
+     * @param[in] payload - section payload data
+     */
+    void append(const Section::Header& header, Section::Payload&& payload);
+
+  private:
+    /* @brief SEL record (IPMI header). */
+    std::optional<SelRecord> selRecord_;
+    /* @brief Array of sections. */
+    SectionValues sections_;
+    /* @brief Indexes of sections of each type. */
+    std::array<std::vector<size_t>, std::variant_size_v<SectionValue>> byType_;
+};
+
+} // namespace eSEL
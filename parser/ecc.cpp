@@ -0,0 +1,143 @@
+/**
+ * @brief ECC of PNOR flash data.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ecc.hpp"
+
+#include <array>
+#include <cstring>
+
+namespace eSEL
+{
+
+/** @brief ECC matrix, each row gives one bit of ECC (see skiboot's libflash).
+ */
+static constexpr uint64_t EccMatrix[] = {
+    0x0000e8423c0f99ffull, 0x00e8423c0f99ff00ull, 0xe8423c0f99ff0000ull,
+    0x423c0f99ff0000e8ull, 0x3c0f99ff0000e842ull, 0x0f99ff0000e8423cull,
+    0x99ff0000e8423c0full, 0xff0000e8423c0f99ull};
+
+/** @brief Syndrome: no errors. */
+static constexpr uint8_t SyndromeGood = 0x40;
+/** @brief Syndrome: error in ECC byte, data is valid. */
+static constexpr uint8_t SyndromeEcc = 0x41;
+/** @brief Syndrome: uncorrectable error. */
+static constexpr uint8_t SyndromeUE = 0x42;
+
+/**
+ * @brief Get parity of 64-bit value.
+ *
+ * @param[in] val - value to check
+ *
+ * @return 1 if number of set bits is odd
+ */
+static constexpr uint8_t parity(uint64_t val)
+{
+    val ^= val >> 32;
+    val ^= val >> 16;
+    val ^= val >> 8;
+    val ^= val >> 4;
+    val ^= val >> 2;
+    val ^= val >> 1;
+    return val & 1;
+}
+
+/**
+ * @brief Generate ECC byte for 64-bit data word.
+ *
+ * @param[in] data - data word in host byte order
+ *
+ * @return ECC byte
+ */
+static constexpr uint8_t eccWord(uint64_t data)
+{
+    uint8_t ecc = 0;
+    for (size_t i = 0; i < 8; ++i)
+        ecc |= parity(EccMatrix[i] & data) << i;
+    return ecc;
+}
+
+/** @brief ECC is linear: ECC of the word is XOR of ECC of its bytes. This
+ *         table contains ECC for each value of each byte of the word. */
+static constexpr std::array<std::array<uint8_t, 256>, 8> ByteEcc = []() {
+    std::array<std::array<uint8_t, 256>, 8> table{};
+    for (size_t pos = 0; pos < 8; ++pos)
+    {
+        for (size_t val = 0; val < 256; ++val)
+        {
+            // Data word is big endian: the first byte is the most significant
+            table[pos][val] = eccWord(static_cast<uint64_t>(val)
+                                      << ((7 - pos) * 8));
+        }
+    }
+    return table;
+}();
+
+/** @brief Syndrome table: syndrome -> number of invalid data bit (IBM bit
+ *         order, 0 is the most significant bit) or syndrome type. */
+static constexpr std::array<uint8_t, 256> Syndromes = []() {
+    std::array<uint8_t, 256> table{};
+    for (auto& it : table)
+        it = SyndromeUE;
+    table[0] = SyndromeGood;
+    for (size_t bit = 0; bit < 8; ++bit)
+        table[1 << bit] = SyndromeEcc;
+    for (size_t bit = 0; bit < 64; ++bit)
+        table[eccWord(1ull << (63 - bit))] = static_cast<uint8_t>(bit);
+    return table;
+}();
+
+uint8_t eccGenerate(const uint8_t* data)
+{
+    return ByteEcc[0][data[0]] ^ ByteEcc[1][data[1]] ^ ByteEcc[2][data[2]] ^
+           ByteEcc[3][data[3]] ^ ByteEcc[4][data[4]] ^ ByteEcc[5][data[5]] ^
+           ByteEcc[6][data[6]] ^ ByteEcc[7][data[7]];
+}
+
+EccStatus removeEcc(const uint8_t* data, size_t len, uint8_t* out)
+{
+    EccStatus status{0, {}};
+
+    const size_t words = len / EccWordSize;
+    for (size_t i = 0; i < words; ++i)
+    {
+        const uint8_t* src = data + i * EccWordSize;
+        uint8_t* dst = out + i * (EccWordSize - 1);
+        memcpy(dst, src, EccWordSize - 1);
+
+        const uint8_t syndrome =
+            Syndromes[eccGenerate(src) ^ src[EccWordSize - 1]];
+        if (syndrome == SyndromeGood)
+            continue;
+        if (syndrome == SyndromeUE)
+            status.uncorrectable.push_back(i * EccWordSize);
+        else
+        {
+            if (syndrome < 64)
+                dst[syndrome / 8] ^= 0x80 >> (syndrome % 8);
+            ++status.corrected;
+        }
+    }
+
+    // Incomplete word
+    const size_t tail = len % EccWordSize;
+    memcpy(out + words * (EccWordSize - 1), data + words * EccWordSize, tail);
+
+    return status;
+}
+
+} // namespace eSEL
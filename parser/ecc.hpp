@@ -0,0 +1,77 @@
+/**
+ * @brief ECC of PNOR flash data.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eSEL
+{
+
+/** @brief Size of ECC protected word: 8 bytes of data and 1 byte of ECC. */
+static constexpr size_t EccWordSize = 9;
+
+/**
+ * @struct EccStatus
+ * @brief Result of ECC check.
+ */
+struct EccStatus
+{
+    size_t corrected;                  ///< Number of corrected words
+    std::vector<size_t> uncorrectable; ///< Offsets of uncorrectable words
+};
+
+/**
+ * @brief Generate ECC byte for 8 bytes of data (SECDED code used by
+ *        OpenPOWER firmware for PNOR partitions).
+ *
+ * @param[in] data - pointer to 8 bytes of data
+ *
+ * @return ECC byte
+ */
+uint8_t eccGenerate(const uint8_t* data);
+
+/**
+ * @brief Get size of data without ECC.
+ *
+ * @param[in] len - size of ECC protected data in bytes
+ *
+ * @return size of data without ECC bytes
+ */
+inline size_t eccDataSize(size_t len)
+{
+    return len - len / EccWordSize;
+}
+
+/**
+ * @brief Verify and remove ECC from protected data.
+ *        Single-bit errors are corrected, uncorrectable words are copied as
+ *        is. Incomplete word at the end of data is copied without check.
+ *
+ * @param[in] data - pointer to ECC protected data
+ * @param[in] len - size of ECC protected data in bytes
+ * @param[out] out - output buffer, at least eccDataSize(len) bytes
+ *
+ * @return ECC check status, offsets of uncorrectable words are counted from
+ *         the start of protected data
+ */
+EccStatus removeEcc(const uint8_t* data, size_t len, uint8_t* out);
+
+} // namespace eSEL
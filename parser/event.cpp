@@ -18,131 +18,87 @@
 
 #include "event.hpp"
 
-#include "section_ph.hpp"
-#include "section_ps.hpp"
-#include "section_ud.hpp"
-#include "section_uh.hpp"
-
-#include <endian.h>
+#include "walker.hpp"
 
 namespace eSEL
 {
 
-/** @brief Create typed section instance.
- *
- *  @return typed section pointer
- */
-static std::unique_ptr<Section> createSection(const Section::Header& header,
-                                              const Section::Payload& payload)
+Event::Event(std::pmr::memory_resource* resource) :
+    sections_(resource), length_(0)
 {
-    Section* section;
-    switch (header.id)
-    {
-        case SectionPH::SectionId:
-            section = new SectionPH(header, payload);
-            break;
-        case SectionPS::SectionId:
-            section = new SectionPS(header, payload);
-            break;
-        case SectionUH::SectionId:
-            section = new SectionUH(header, payload);
-            break;
-        case SectionUD::SectionId:
-            section = new SectionUD(header, payload);
-            break;
-        default:
-            section = new Section(header, payload);
-    }
+}
 
-    return std::unique_ptr<Section>(section);
+void Event::parse(const uint8_t* data, size_t len)
+{
+    throwOnError(tryParse(data, len));
 }
 
-/** @brief Construct section instance from eSEL BLOB stream.
- *
- *  @param[in] data - pointer to eSEL BLOB data
- *  @param[in] len - size of eSEL BLOB data in bytes
- *
- *  @return typed section pointer
- *
- *  @throws InvalidFormat if there is an error in eSEL BLOB
- */
-static std::unique_ptr<Section> fetchSection(const uint8_t* data, size_t len)
+ParseStatus Event::tryParse(const uint8_t* data, size_t len) noexcept
 {
-    if (len <= sizeof(Section::Header))
+    /** @brief Sink for section walker: creates typed sections. */
+    struct Sink
     {
-        throw InvalidFormat(
-            "Input buffer (%zu bytes) is smaller than header size (%zu)", len,
-            sizeof(Section::Header));
-    }
-
-    // Read section header
-    Section::Header header = *reinterpret_cast<const Section::Header*>(data);
-    header.id = be16toh(header.id);
-    header.length = be16toh(header.length);
-    header.component = be16toh(header.component);
-
-    // Check section header
-    if (header.length <= sizeof(Section::Header))
+        void reserve(size_t count)
+        {
+            sections.reserve(count);
+        }
+        ParseError append(const SectionView& section)
+        {
+            if (!checkPayloadSize(section.header))
+                return ParseError::PayloadSize;
+            // Read section payload, the only copy of the data made by parser
+            std::pmr::memory_resource* resource =
+                sections.get_allocator().resource();
+            Section::Payload payload(section.payload.begin(),
+                                     section.payload.end(), resource);
+            sections.emplace_back(
+                createSection(section.header, std::move(payload), resource));
+            return ParseError::None;
+        }
+        Sections& sections;
+    } sink{sections_};
+
+    try
     {
-        throw InvalidFormat("Section length (%u) is too small",
-                            static_cast<uint16_t>(header.length));
+        return walkEvent(data, len, selRecord_, length_, sink);
     }
-    if (header.length > len)
+    catch (const std::bad_alloc&)
     {
-        throw InvalidFormat(
-            "Section length (%u) is bigger then buffer size (%zu)",
-            static_cast<uint16_t>(header.length), len);
+        return {ParseError::OutOfMemory, 0};
     }
-
-    // Read section payload
-    const Section::Payload payload(data + sizeof(header), data + header.length);
-
-    return createSection(header, payload);
 }
 
-void Event::parse(const uint8_t* data, size_t len)
+void Event::decode(
+    ThreadPool& pool,
+    const std::function<bool(size_t)>& filter /*= nullptr*/) const
 {
-    // Check input parameters
-    if (!data)
-        throw InvalidFormat("Invalid input buffer");
-    if (len < sizeof(SectionPH::PHData))
-        throw InvalidFormat("eSEL buffer too small");
-
-    size_t pos = 0;
-
-    // eSEL always starts with Private Header, this is the first section.
-    // But in some cases we may have SEL record at the top of raw data.
-    uint16_t sid = *reinterpret_cast<const uint16_t*>(data);
-    if (be16toh(sid) != SectionPH::SectionId)
+    std::vector<std::future<void>> results;
+    results.reserve(sections_.size());
+    for (size_t i = 0; i < sections_.size(); ++i)
     {
-        selRecord_ = SelRecord(data, len);
-        pos += sizeof(SelRecord);
+        if (filter && !filter(i))
+            continue;
+        const Section* section = sections_[i].get();
+        results.emplace_back(
+            pool.submit([section]() { section->payloadParams(); }));
     }
 
-    // Check for starting point of the first section (Private Header)
-    if (len < pos + sizeof(SectionPH::PHData))
-        throw InvalidFormat("eSEL buffer too small to fit Private Header");
-    sid = *reinterpret_cast<const uint16_t*>(data + pos);
-    if (be16toh(sid) != SectionPH::SectionId)
-        throw InvalidFormat("Private Header section not found");
-
-    // Parse the first section (Private Header) to get sections count
-    std::unique_ptr<Section> phSection = fetchSection(data + pos, len - pos);
-    pos += phSection->header().length;
-    const size_t sectionsCount =
-        reinterpret_cast<SectionPH*>(phSection.get())->data().sectionCount;
-    sections_.reserve(sectionsCount);
-    sections_.emplace_back(std::move(phSection));
-
-    // Parse remaining part of eSEL BLOB
-    for (size_t i = 1 /* skip first section */; i < sectionsCount; ++i)
+    // Wait for all tasks before throwing, the sections must stay alive
+    std::exception_ptr error;
+    for (auto& it : results)
     {
-        if (pos >= len)
-            throw InvalidFormat("Unexpected buffer end at offset %zu", pos);
-        std::unique_ptr<Section> section = fetchSection(data + pos, len - pos);
-        pos += section->header().length;
-        sections_.emplace_back(std::move(section));
+        try
+        {
+            it.get();
+        }
+        catch (...)
+        {
+            if (!error)
+                error = std::current_exception();
+        }
     }
+    if (error)
+        std::rethrow_exception(error);
 }
 
 const Sections& Event::getSections() const
@@ -155,4 +111,9 @@ std::optional<SelRecord> Event::getSelRecord() const
     return selRecord_;
 }
 
+size_t Event::length() const
+{
+    return length_;
+}
+
 } // namespace eSEL
@@ -19,9 +19,13 @@
 #pragma once
 
 #include "fmtexcept.hpp"
+#include "parse_status.hpp"
 #include "section.hpp"
 #include "sel_record.hpp"
+#include "thread_pool.hpp"
 
+#include <functional>
+#include <memory_resource>
 #include <optional>
 
 namespace eSEL
@@ -34,6 +38,15 @@ namespace eSEL
 class Event
 {
   public:
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] resource - memory resource used for the sections, their
+     *                       payloads and decoded parameters
+     */
+    explicit Event(std::pmr::memory_resource* resource =
+                       std::pmr::get_default_resource());
+
     /**
      * @brief Parse eSEL from raw binary data.
      *
@@ -44,6 +57,34 @@ class Event
      */
     void parse(const uint8_t* data, size_t len);
 
+    /**
+     * @brief Parse eSEL from raw binary data without exceptions.
+     *        In case of errors, the event keeps the sections parsed before
+     *        the error.
+     *
+     * @param[in] data - pointer to the data buffer
+     * @param[in] len - size of the data buffer in bytes
+     *
+     * @return parsing status
+     */
+    ParseStatus tryParse(const uint8_t* data, size_t len) noexcept;
+
+    /**
+     * @brief Decode payloads of sections concurrently.
+     *        Section headers are already known after parsing, so the slow
+     *        payload decoders (HostBoot plugins, fsp-trace) can run in
+     *        parallel. Decoded parameters are cached by sections, sections
+     *        order is kept.
+     *
+     * @param[in] pool - thread pool used for decoding
+     * @param[in] filter - predicate to select sections by index, all
+     *                     sections are decoded if it is empty
+     *
+     * @throws any exception thrown by section decoder
+     */
+    void decode(ThreadPool& pool,
+                const std::function<bool(size_t)>& filter = nullptr) const;
+
     /**
      * @brief Get sections array.
      *
@@ -58,11 +99,20 @@ class Event
      */
     std::optional<SelRecord> getSelRecord() const;
 
+    /**
+     * @brief Get size of the parsed eSEL.
+     *
+     * @return number of bytes occupied by SEL record and sections
+     */
+    size_t length() const;
+
   private:
     /* @brief SEL record (IPMI header). */
     std::optional<SelRecord> selRecord_;
     /* @brief Array of sections. */
     Sections sections_;
+    /* @brief Size of the parsed eSEL in bytes. */
+    size_t length_;
 };
 
 } // namespace eSEL
@@ -0,0 +1,123 @@
+/**
+ * @brief Batch of eSEL events sharing the same memory arena.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_batch.hpp"
+
+#include "section_ph.hpp"
+
+#include <endian.h>
+
+namespace eSEL
+{
+
+EventBatch::Entry::Entry(std::pmr::memory_resource* resource) :
+    event(resource), status{ParseError::None, 0}
+{
+}
+
+EventBatch::EventBatch(size_t initialSize /*= 64 * 1024*/) :
+    arena_(initialSize), events_(&arena_)
+{
+}
+
+void EventBatch::parse(const std::vector<ByteSpan>& buffers)
+{
+    events_.reserve(events_.size() + buffers.size());
+    for (const auto& buf : buffers)
+        append(buf.data(), buf.size());
+}
+
+void EventBatch::parse(const uint8_t* data, size_t len,
+                       size_t slotSize /*= 0*/)
+{
+    if (slotSize)
+    {
+        events_.reserve(events_.size() + len / slotSize);
+        for (size_t pos = 0; pos + slotSize <= len; pos += slotSize)
+        {
+            // Check Private Header section existing
+            const uint16_t sid =
+                *reinterpret_cast<const uint16_t*>(data + pos);
+            if (be16toh(sid) != SectionPH::SectionId)
+                break;
+            append(data + pos, slotSize);
+        }
+    }
+    else
+    {
+        size_t pos = 0;
+        while (pos < len)
+        {
+            const Entry& entry = append(data + pos, len - pos);
+            if (!entry.status)
+                break;
+            pos += entry.event.length();
+        }
+    }
+}
+
+const EventBatch::Entries& EventBatch::getEvents() const
+{
+    return events_;
+}
+
+void EventBatch::clear()
+{
+    // Destroy the events and drop the array storage before releasing the
+    // arena
+    Entries(&arena_).swap(events_);
+    arena_.release();
+}
+
+const EventBatch::Entry& EventBatch::append(const uint8_t* data, size_t len)
+{
+    Entry& entry = events_.emplace_back(&arena_);
+    entry.data = ByteSpan(data, len);
+    entry.status = entry.event.tryParse(data, len);
+    return entry;
+}
+
+EventBatch::Arena::Arena(size_t initialSize) : resource_(initialSize)
+{
+}
+
+void EventBatch::Arena::release()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    resource_.release();
+}
+
+void* EventBatch::Arena::do_allocate(size_t bytes, size_t alignment)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return resource_.allocate(bytes, alignment);
+}
+
+void EventBatch::Arena::do_deallocate(void* /*ptr*/, size_t /*bytes*/,
+                                      size_t /*alignment*/)
+{
+    // Monotonic arena releases memory only at once
+}
+
+bool EventBatch::Arena::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+} // namespace eSEL
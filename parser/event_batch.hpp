@@ -0,0 +1,161 @@
+/**
+ * @brief Batch of eSEL events sharing the same memory arena.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "byte_span.hpp"
+#include "event.hpp"
+#include "parse_status.hpp"
+
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace eSEL
+{
+
+/**
+ * @class EventBatch
+ * @brief Batch of eSEL events.
+ *        All the memory used by events (arrays of sections, sections with
+ *        their payloads, decoded parameters and their string values) is
+ *        taken from a single monotonic arena and released at once when the
+ *        batch is cleared or destroyed. Sections of the batch can be decoded
+ *        by different threads. Events and sections must not be used after
+ *        the batch is cleared.
+ */
+class EventBatch
+{
+  public:
+    /**
+     * @struct Entry
+     * @brief Batch entry: parsed event and parsing status.
+     */
+    struct Entry
+    {
+        /**
+         * @brief Constructor.
+         *
+         * @param[in] resource - memory resource used for the entry's data
+         */
+        explicit Entry(std::pmr::memory_resource* resource);
+
+        ByteSpan data;      ///< Source data of the event
+        Event event;        ///< Parsed event, partial in case of errors
+        ParseStatus status; ///< Parsing status
+    };
+
+    /** @brief Array of batch entries. */
+    using Entries = std::pmr::vector<Entry>;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] initialSize - size of the first arena block in bytes
+     */
+    explicit EventBatch(size_t initialSize = 64 * 1024);
+
+    EventBatch(const EventBatch&) = delete;
+    EventBatch& operator=(const EventBatch&) = delete;
+
+    /**
+     * @brief Parse events from list of buffers, one event per buffer.
+     *        Buffers must outlive the parsed events.
+     *
+     * @param[in] buffers - array of source buffers
+     */
+    void parse(const std::vector<ByteSpan>& buffers);
+
+    /**
+     * @brief Parse events from a contiguous image.
+     *        If slot size is set, each event occupies a fixed size slot (e.g.
+     *        HBEL partition of PNOR) and parsing stops at the first slot that
+     *        doesn't start with Private Header. Otherwise events are expected
+     *        to follow each other without gaps and parsing stops at the first
+     *        error.
+     *
+     * @param[in] data - pointer to the image
+     * @param[in] len - size of the image in bytes
+     * @param[in] slotSize - size of event's slot in bytes, 0 if not used
+     */
+    void parse(const uint8_t* data, size_t len, size_t slotSize = 0);
+
+    /**
+     * @brief Get parsed events.
+     *
+     * @return array of batch entries
+     */
+    const Entries& getEvents() const;
+
+    /**
+     * @brief Remove all events and release the memory of the arena.
+     */
+    void clear();
+
+  private:
+    /**
+     * @class Arena
+     * @brief Monotonic memory resource guarded by a mutex.
+     */
+    class Arena : public std::pmr::memory_resource
+    {
+      public:
+        /**
+         * @brief Constructor.
+         *
+         * @param[in] initialSize - size of the first block in bytes
+         */
+        explicit Arena(size_t initialSize);
+
+        /**
+         * @brief Release all allocated memory.
+         */
+        void release();
+
+      private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* ptr, size_t bytes,
+                           size_t alignment) override;
+        bool do_is_equal(
+            const std::pmr::memory_resource& other) const noexcept override;
+
+      private:
+        /** @brief Mutex to guard the resource. */
+        std::mutex mutex_;
+        /** @brief Underlying memory resource. */
+        std::pmr::monotonic_buffer_resource resource_;
+    };
+
+    /**
+     * @brief Parse single event and append it to the batch.
+     *
+     * @param[in] data - pointer to the data buffer
+     * @param[in] len - size of the data buffer in bytes
+     *
+     * @return appended entry
+     */
+    const Entry& append(const uint8_t* data, size_t len);
+
+  private:
+    /** @brief Memory arena. */
+    Arena arena_;
+    /** @brief Parsed events. */
+    Entries events_;
+};
+
+} // namespace eSEL
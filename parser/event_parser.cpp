@@ -0,0 +1,182 @@
+/**
+ * @brief Incremental (push) parser of eSEL.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_parser.hpp"
+
+#include "walker.hpp"
+
+#include <cstring>
+
+namespace eSEL
+{
+
+static_assert(sizeof(SelRecord) >= sizeof(Section::Header),
+              "Buffer must fit section header");
+
+EventParser::EventParser(SectionHandler handler) : handler_(std::move(handler))
+{
+    reset();
+}
+
+ParseStatus EventParser::feed(const uint8_t* data, size_t len)
+{
+    if (!data && len)
+        fail(ParseError::InvalidBuffer, length_);
+
+    try
+    {
+        while (len && state_ != State::Complete && state_ != State::Failed)
+        {
+            switch (state_)
+            {
+                case State::Start:
+                    if (fill(data, len, sizeof(Section::Header)))
+                    {
+                        // eSEL always starts with Private Header, but in some
+                        // cases we may have SEL record at the top of raw data.
+                        uint16_t sid;
+                        memcpy(&sid, buffer_.data(), sizeof(sid));
+                        if (be16toh(sid) == SectionPH::SectionId)
+                            startSection();
+                        else
+                            state_ = State::SelRecord;
+                    }
+                    break;
+                case State::SelRecord:
+                    if (fill(data, len, sizeof(SelRecord)))
+                    {
+                        selRecord_ = SelRecord(buffer_.data(), filled_);
+                        filled_ = 0;
+                        state_ = State::Header;
+                    }
+                    break;
+                case State::Header:
+                    if (fill(data, len, sizeof(Section::Header)))
+                        startSection();
+                    break;
+                case State::Payload:
+                {
+                    const size_t need = header_.length -
+                                        sizeof(Section::Header) -
+                                        payload_.size();
+                    const size_t size = std::min(need, len);
+                    payload_.insert(payload_.end(), data, data + size);
+                    data += size;
+                    len -= size;
+                    length_ += size;
+                    if (size == need)
+                        finishSection();
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        fail(ParseError::OutOfMemory, length_);
+    }
+
+    return status_;
+}
+
+bool EventParser::complete() const
+{
+    return state_ == State::Complete;
+}
+
+std::optional<SelRecord> EventParser::getSelRecord() const
+{
+    return selRecord_;
+}
+
+size_t EventParser::length() const
+{
+    return length_;
+}
+
+void EventParser::reset()
+{
+    state_ = State::Start;
+    status_ = {ParseError::None, 0};
+    filled_ = 0;
+    payload_.clear();
+    sectionStart_ = 0;
+    sectionsDone_ = 0;
+    sectionsCount_ = 0;
+    length_ = 0;
+    selRecord_.reset();
+}
+
+bool EventParser::fill(const uint8_t*& data, size_t& len, size_t required)
+{
+    const size_t size = std::min(required - filled_, len);
+    memcpy(buffer_.data() + filled_, data, size);
+    filled_ += size;
+    data += size;
+    len -= size;
+    length_ += size;
+    return filled_ == required;
+}
+
+void EventParser::startSection()
+{
+    sectionStart_ = length_ - sizeof(Section::Header);
+    filled_ = 0;
+
+    // Section length can't be checked here, the rest of the section is not
+    // received yet, so let the header reader think that buffer is unlimited.
+    const ParseError rc =
+        Section::readHeader(buffer_.data(), SIZE_MAX, header_);
+    if (sectionsDone_ == 0 && header_.id != SectionPH::SectionId)
+        return fail(ParseError::NoPrivateHeader, sectionStart_);
+    if (rc != ParseError::None)
+        return fail(rc, sectionStart_);
+    if (!checkPayloadSize(header_))
+        return fail(ParseError::PayloadSize, sectionStart_);
+
+    payload_.clear();
+    payload_.reserve(header_.length - sizeof(Section::Header));
+    state_ = State::Payload;
+}
+
+void EventParser::finishSection()
+{
+    if (sectionsDone_ == 0)
+    {
+        // Get sections count from the first section (Private Header)
+        const SectionPH::PHData* ph =
+            reinterpret_cast<const SectionPH::PHData*>(payload_.data());
+        sectionsCount_ = std::max<size_t>(1, ph->sectionCount);
+    }
+
+    ++sectionsDone_;
+    state_ = sectionsDone_ == sectionsCount_ ? State::Complete : State::Header;
+
+    handler_(createSection(header_, std::move(payload_)));
+    payload_ = Section::Payload();
+}
+
+void EventParser::fail(ParseError error, size_t offset)
+{
+    state_ = State::Failed;
+    status_ = {error, offset};
+}
+
+} // namespace eSEL
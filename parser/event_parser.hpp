@@ -0,0 +1,162 @@
+/**
+ * @brief Incremental (push) parser of eSEL.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "parse_status.hpp"
+#include "section.hpp"
+#include "sel_record.hpp"
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace eSEL
+{
+
+/**
+ * @class EventParser
+ * @brief Push parser of eSEL.
+ *        Raw data is fed in chunks of any size (IPMI fragments, pipe reads,
+ *        etc), the parser keeps its state between the chunks and passes each
+ *        section to the handler as soon as the last byte of the section has
+ *        arrived. Only the section being received is buffered.
+ */
+class EventParser
+{
+  public:
+    /** @brief Handler of completed sections. */
+    using SectionHandler = std::function<void(std::unique_ptr<Section>)>;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] handler - handler of completed sections
+     */
+    explicit EventParser(SectionHandler handler);
+
+    /**
+     * @brief Feed the next chunk of raw data.
+     *        Data past the end of eSEL is ignored. After an error the parser
+     *        refuses any data until reset.
+     *
+     * @param[in] data - pointer to the data chunk
+     * @param[in] len - size of the data chunk in bytes
+     *
+     * @return parsing status, offset is counted from the start of eSEL
+     *
+     * @throws any exception thrown by the section handler
+     */
+    ParseStatus feed(const uint8_t* data, size_t len);
+
+    /**
+     * @brief Check if the whole eSEL has been parsed.
+     *
+     * @return true if the last section has been passed to the handler
+     */
+    bool complete() const;
+
+    /**
+     * @brief Get SEL record.
+     *
+     * @return SEL record instance or std::nullopt if event doesn't contain one
+     */
+    std::optional<SelRecord> getSelRecord() const;
+
+    /**
+     * @brief Get number of bytes consumed by the parser.
+     *
+     * @return size of the eSEL part received so far
+     */
+    size_t length() const;
+
+    /**
+     * @brief Reset the parser to start the next eSEL.
+     */
+    void reset();
+
+  private:
+    /** @brief Parser states. */
+    enum class State
+    {
+        Start,     ///< Waiting for SEL record or Private Header
+        SelRecord, ///< Receiving SEL record
+        Header,    ///< Receiving section header
+        Payload,   ///< Receiving section payload
+        Complete,  ///< All sections received
+        Failed     ///< Parsing error
+    };
+
+    /**
+     * @brief Move data from the chunk to the fixed size buffer.
+     *
+     * @param[in,out] data - pointer to the data chunk
+     * @param[in,out] len - size of the data chunk in bytes
+     * @param[in] required - required number of bytes in the buffer
+     *
+     * @return true if the buffer has required number of bytes
+     */
+    bool fill(const uint8_t*& data, size_t& len, size_t required);
+
+    /**
+     * @brief Start receiving the section which header is in the buffer.
+     */
+    void startSection();
+
+    /**
+     * @brief Pass the received section to the handler.
+     */
+    void finishSection();
+
+    /**
+     * @brief Switch to the failed state.
+     *
+     * @param[in] error - error code
+     * @param[in] offset - offset of the error
+     */
+    void fail(ParseError error, size_t offset);
+
+  private:
+    /** @brief Handler of completed sections. */
+    SectionHandler handler_;
+    /** @brief Current state. */
+    State state_;
+    /** @brief Parsing status. */
+    ParseStatus status_;
+    /** @brief Buffer for SEL record and section headers. */
+    std::array<uint8_t, sizeof(SelRecord)> buffer_;
+    /** @brief Number of bytes in the buffer. */
+    size_t filled_;
+    /** @brief Header of the section being received. */
+    Section::Header header_;
+    /** @brief Payload of the section being received. */
+    Section::Payload payload_;
+    /** @brief Offset of the section being received. */
+    size_t sectionStart_;
+    /** @brief Number of sections passed to the handler. */
+    size_t sectionsDone_;
+    /** @brief Total number of sections, taken from Private Header. */
+    size_t sectionsCount_;
+    /** @brief Number of bytes consumed. */
+    size_t length_;
+    /** @brief SEL record (IPMI header). */
+    std::optional<SelRecord> selRecord_;
+};
+
+} // namespace eSEL
@@ -0,0 +1,78 @@
+/**
+ * @brief Non-owning view of eSEL (OpenPOWER Platform Event Log record).
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_view.hpp"
+
+#include "walker.hpp"
+
+namespace eSEL
+{
+
+EventView::EventView(std::pmr::memory_resource* resource) :
+    sections_(resource), length_(0)
+{
+}
+
+void EventView::parse(const uint8_t* data, size_t len)
+{
+    throwOnError(tryParse(data, len));
+}
+
+ParseStatus EventView::tryParse(const uint8_t* data, size_t len) noexcept
+{
+    /** @brief Sink for section walker: collects section views. */
+    struct Sink
+    {
+        void reserve(size_t count)
+        {
+            sections.reserve(count);
+        }
+        ParseError append(const SectionView& section)
+        {
+            sections.emplace_back(section);
+            return ParseError::None;
+        }
+        SectionViews& sections;
+    } sink{sections_};
+
+    try
+    {
+        return walkEvent(data, len, selRecord_, length_, sink);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return {ParseError::OutOfMemory, 0};
+    }
+}
+
+const SectionViews& EventView::getSections() const
+{
+    return sections_;
+}
+
+std::optional<SelRecord> EventView::getSelRecord() const
+{
+    return selRecord_;
+}
+
+size_t EventView::length() const
+{
+    return length_;
+}
+
+} // namespace eSEL
@@ -0,0 +1,115 @@
+/**
+ * @brief Non-owning view of eSEL (OpenPOWER Platform Event Log record).
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "byte_span.hpp"
+#include "fmtexcept.hpp"
+#include "parse_status.hpp"
+#include "section.hpp"
+#include "sel_record.hpp"
+
+#include <memory_resource>
+#include <optional>
+
+namespace eSEL
+{
+
+/**
+ * @struct SectionView
+ * @brief Section of eSEL that refers to the source buffer.
+ */
+struct SectionView
+{
+    Section::Header header; ///< Section header in host byte order
+    ByteSpan payload;       ///< Section payload inside the source buffer
+};
+
+/** @brief Section views array. */
+using SectionViews = std::pmr::vector<SectionView>;
+
+/**
+ * @class EventView
+ * @brief eSEL event that borrows the source buffer instead of copying it.
+ *        Payloads of sections are not copied and not decoded, the source
+ *        buffer must outlive the view.
+ */
+class EventView
+{
+  public:
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] resource - memory resource used for the sections array
+     */
+    explicit EventView(std::pmr::memory_resource* resource =
+                           std::pmr::get_default_resource());
+
+    /**
+     * @brief Parse eSEL from raw binary data.
+     *
+     * @param[in] data - pointer to the data buffer
+     * @param[in] len - size of the data buffer in bytes
+     *
+     * @throws InvalidFormat in case of errors
+     */
+    void parse(const uint8_t* data, size_t len);
+
+    /**
+     * @brief Parse eSEL from raw binary data without exceptions.
+     *        In case of errors, the view keeps the sections parsed before
+     *        the error.
+     *
+     * @param[in] data - pointer to the data buffer
+     * @param[in] len - size of the data buffer in bytes
+     *
+     * @return parsing status
+     */
+    ParseStatus tryParse(const uint8_t* data, size_t len) noexcept;
+
+    /**
+     * @brief Get sections array.
+     *
+     * @return array of event's section views
+     */
+    const SectionViews& getSections() const;
+
+    /**
+     * @brief Get SEL record.
+     *
+     * @return SEL record instance or std::nullopt if event doesn't contain one
+     */
+    std::optional<SelRecord> getSelRecord() const;
+
+    /**
+     * @brief Get size of the parsed eSEL.
+     *
+     * @return number of bytes occupied by SEL record and sections
+     */
+    size_t length() const;
+
+  private:
+    /* @brief SEL record (IPMI header). */
+    std::optional<SelRecord> selRecord_;
+    /* @brief Array of section views. */
+    SectionViews sections_;
+    /* @brief Size of the parsed eSEL in bytes. */
+    size_t length_;
+};
+
+} // namespace eSEL
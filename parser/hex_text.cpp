@@ -0,0 +1,204 @@
+/**
+ * @brief Decoder of hex text.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hex_text.hpp"
+
+#include "fmtexcept.hpp"
+
+#include <array>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace eSEL
+{
+
+/** @brief Character class: white space. */
+static constexpr uint8_t HexSpace = 0x10;
+/** @brief Character class: neither hex digit nor white space. */
+static constexpr uint8_t HexInvalid = 0xff;
+
+/** @brief Lookup table: character -> hex digit value or character class. */
+static constexpr std::array<uint8_t, 256> HexTable = []() {
+    std::array<uint8_t, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i)
+    {
+        if (i >= '0' && i <= '9')
+            table[i] = i - '0';
+        else if (i >= 'a' && i <= 'f')
+            table[i] = i - 'a' + 10;
+        else if (i >= 'A' && i <= 'F')
+            table[i] = i - 'A' + 10;
+        else if (i == ' ' || (i >= '\t' && i <= '\r'))
+            table[i] = HexSpace;
+        else
+            table[i] = HexInvalid;
+    }
+    return table;
+}();
+
+/**
+ * @brief Get value of the hex digit or class of the character.
+ *
+ * @param[in] ch - character
+ *
+ * @return digit value, HexSpace or HexInvalid
+ */
+static inline uint8_t hexValue(char ch)
+{
+    return HexTable[static_cast<uint8_t>(ch)];
+}
+
+#ifdef __SSE2__
+/**
+ * @brief Get mask of hex digits and their values.
+ *
+ * @param[in] chars - 16 characters
+ * @param[out] values - values of hex digits
+ *
+ * @return bit mask of hex digits
+ */
+static inline int hexDigits16(__m128i chars, __m128i& values)
+{
+    // Signed comparison is safe: non-ASCII characters are negative
+    const __m128i digit =
+        _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                      _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+    const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    const __m128i letter =
+        _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                      _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+
+    values = _mm_or_si128(
+        _mm_and_si128(digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+        _mm_and_si128(letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+
+    return _mm_movemask_epi8(_mm_or_si128(digit, letter));
+}
+
+/**
+ * @brief Decode 16 hex digits without separators.
+ *
+ * @param[in] text - source text, 16 characters
+ * @param[out] out - output buffer, 8 bytes
+ *
+ * @return false if text contains not only hex digits
+ */
+static inline bool decodeDense(const char* text, uint8_t* out)
+{
+    __m128i values;
+    const __m128i chars =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(text));
+    if (hexDigits16(chars, values) != 0xffff)
+        return false;
+
+    // Join pairs of digits: high nibble is the first (lower) byte of 16-bit
+    // lane, low nibble is the second one
+    const __m128i high = _mm_slli_epi16(
+        _mm_and_si128(values, _mm_set1_epi16(0x00ff)), 4);
+    const __m128i low = _mm_srli_epi16(values, 8);
+    const __m128i bytes =
+        _mm_packus_epi16(_mm_or_si128(high, low), _mm_setzero_si128());
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), bytes);
+
+    return true;
+}
+
+/**
+ * @brief Decode 16 bytes in "xx xx ... xx " format (48 characters).
+ *
+ * @param[in] text - source text, 48 characters
+ * @param[out] out - output buffer, 16 bytes
+ *
+ * @return false if text has another format
+ */
+static inline bool decodeSpaced(const char* text, uint8_t* out)
+{
+    // Masks of space positions inside each 16 characters of 48
+    static constexpr int spaces[] = {0x4924, 0x2492, 0x9249};
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        __m128i values;
+        const __m128i chars =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i * 16));
+        const int space =
+            _mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')));
+        if (space != spaces[i] ||
+            hexDigits16(chars, values) != (~spaces[i] & 0xffff))
+            return false;
+    }
+
+    // Format is validated, use lookup table without checks
+    for (size_t i = 0; i < 16; ++i, text += 3)
+        out[i] = (hexValue(text[0]) << 4) | hexValue(text[1]);
+
+    return true;
+}
+#endif
+
+size_t decodeHexText(const char* text, size_t len, std::vector<uint8_t>& out,
+                     bool final /*= true*/)
+{
+    // Reserve for the worst case, shrink to the real size at the end
+    const size_t start = out.size();
+    out.resize(start + len / 2);
+    uint8_t* dst = out.data() + start;
+
+    size_t pos = 0;
+    while (pos < len)
+    {
+#ifdef __SSE2__
+        if (len - pos >= 48 && decodeSpaced(text + pos, dst))
+        {
+            pos += 48;
+            dst += 16;
+            continue;
+        }
+        if (len - pos >= 16 && decodeDense(text + pos, dst))
+        {
+            pos += 16;
+            dst += 8;
+            continue;
+        }
+#endif
+        const uint8_t high = hexValue(text[pos]);
+        if (high == HexSpace)
+        {
+            ++pos;
+            continue;
+        }
+        if (high == HexInvalid)
+            break; // end of hex text
+        if (pos + 1 == len && !final)
+            break; // the second digit is in the next block
+
+        const uint8_t low = pos + 1 < len ? hexValue(text[pos + 1]) : HexSpace;
+        if (low > 0x0f)
+            throw InvalidFormat("Invalid hex format at position %zu", pos);
+        *dst++ = (high << 4) | low;
+        pos += 2;
+    }
+
+    out.resize(dst - out.data());
+
+    return pos;
+}
+
+} // namespace eSEL
@@ -0,0 +1,49 @@
+/**
+ * @brief Decoder of hex text.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eSEL
+{
+
+/**
+ * @brief Decode hex text to binary data.
+ *        Text is a sequence of bytes, two hex digits each, bytes may be
+ *        separated by white spaces (e.g. "50 48 00 30" or "50480030").
+ *        Decoding stops at the first character that is neither a hex digit
+ *        nor a white space.
+ *
+ * @param[in] text - source text
+ * @param[in] len - length of the text in bytes
+ * @param[out] out - array to append decoded data
+ * @param[in] final - false if the text is a block of stream that continues
+ *                    in the next block: a single hex digit at the end is not
+ *                    decoded, it has to be passed again with the next block
+ *
+ * @return number of processed characters
+ *
+ * @throws InvalidFormat if a byte has only one hex digit
+ */
+size_t decodeHexText(const char* text, size_t len, std::vector<uint8_t>& out,
+                     bool final = true);
+
+} // namespace eSEL
@@ -18,55 +18,110 @@
 
 #include "hexdump.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 namespace eSEL
 {
 
-std::string hexDump(const void* data, size_t len, bool offset /*= true*/,
-                    bool ascii /*= true*/)
-{
-    std::string hexView;
+/** @brief Number of bytes in a single row of hex dump. */
+static constexpr size_t BytesInRow = 16;
+/** @brief Number of bytes in a group of hex dump row. */
+static constexpr size_t BytesInGroup = 4;
+/** @brief Size of offset field: "0000:   ". */
+static constexpr size_t OffsetLen = 8;
+/** @brief Size of hex field: 2 digits and space per byte, group delimiters. */
+static constexpr size_t HexRowLen =
+    BytesInRow * 3 /* hex and space */ + BytesInRow / BytesInGroup;
 
-    const uint8_t* buf = reinterpret_cast<const uint8_t*>(data);
+/** @brief Lookup table: byte -> two hex digits. */
+static constexpr std::array<std::array<char, 2>, 256> HexTable = []() {
+    constexpr char digits[] = "0123456789abcdef";
+    std::array<std::array<char, 2>, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i)
+    {
+        table[i][0] = digits[i >> 4];
+        table[i][1] = digits[i & 0x0f];
+    }
+    return table;
+}();
 
-    const size_t bytesInRow = 16;
-    const size_t hexRowLen = bytesInRow * 2 /* hex */ +
-                             bytesInRow /* spaces */ +
-                             bytesInRow / 4 /* group delimiters */;
+/** @brief Lookup table: byte -> ASCII view (printable character or dot). */
+static constexpr std::array<char, 256> AsciiTable = []() {
+    std::array<char, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i)
+        table[i] = i >= 0x20 && i < 0x7f ? static_cast<char>(i) : '.';
+    return table;
+}();
 
-    std::string rowHex;
-    rowHex.reserve(hexRowLen);
-    std::string rowAscii;
-    rowAscii.reserve(bytesInRow);
+size_t hexDumpSize(size_t len, bool offset /*= true*/, bool ascii /*= true*/)
+{
+    const size_t rows = (len + BytesInRow - 1) / BytesInRow;
+    if (!rows)
+        return 0;
+
+    size_t size = rows * HexRowLen + rows - 1 /* new lines */;
+    if (offset)
+        size += rows * OffsetLen;
+    if (ascii)
+        size += rows /* delimiter */ + len;
+    return size;
+}
 
-    for (size_t row = 0; row * bytesInRow < len; ++row)
+char* hexDump(char* out, const void* data, size_t len, bool offset /*= true*/,
+              bool ascii /*= true*/)
+{
+    const uint8_t* buf = reinterpret_cast<const uint8_t*>(data);
+
+    for (size_t rowStart = 0; rowStart < len; rowStart += BytesInRow)
     {
-        if (!hexView.empty())
-            hexView += '\n';
-        const size_t rowStart = row * bytesInRow;
-        const size_t rowEnd = std::min(rowStart + bytesInRow, len);
-        for (size_t pos = rowStart; pos < rowEnd; ++pos)
-        {
-            if (pos != rowStart && pos % 4 == 0)
-                rowHex += ' ';
-            rowHex += toHex(buf[pos], false) + ' ';
-            if (ascii)
-                rowAscii += std::isprint(buf[pos]) ? buf[pos] : '.';
-        }
+        if (rowStart)
+            *out++ = '\n';
+
         if (offset)
         {
-            hexView += toHex(static_cast<uint16_t>(rowStart), false);
-            hexView += ":   ";
+            // Offset is always printed as 16-bit value
+            const uint16_t addr = static_cast<uint16_t>(rowStart);
+            memcpy(out, HexTable[addr >> 8].data(), 2);
+            memcpy(out + 2, HexTable[addr & 0xff].data(), 2);
+            memcpy(out + 4, ":   ", 4);
+            out += OffsetLen;
         }
-        rowHex.resize(hexRowLen, ' ');
-        hexView += rowHex;
+
+        const size_t rowLen = std::min(BytesInRow, len - rowStart);
+        const uint8_t* row = buf + rowStart;
+
+        // Hex view: fixed positions inside the space-filled field
+        memset(out, ' ', HexRowLen);
+        for (size_t i = 0; i < rowLen; ++i)
+            memcpy(out + i * 3 + i / BytesInGroup, HexTable[row[i]].data(), 2);
+        out += HexRowLen;
+
         if (ascii)
         {
-            hexView += ' ';
-            hexView += rowAscii;
+            *out++ = ' ';
+            for (size_t i = 0; i < rowLen; ++i)
+                *out++ = AsciiTable[row[i]];
         }
-        rowHex.clear();
-        rowAscii.clear();
     }
+
+    return out;
+}
+
+void appendHexDump(std::string& out, const void* data, size_t len,
+                   bool offset /*= true*/, bool ascii /*= true*/)
+{
+    const size_t pos = out.size();
+    out.resize(pos + hexDumpSize(len, offset, ascii));
+    hexDump(out.data() + pos, data, len, offset, ascii);
+}
+
+std::string hexDump(const void* data, size_t len, bool offset /*= true*/,
+                    bool ascii /*= true*/)
+{
+    std::string hexView;
+    appendHexDump(hexView, data, len, offset, ascii);
     return hexView;
 }
 
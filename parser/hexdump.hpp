@@ -24,40 +24,92 @@ namespace eSEL
 {
 
 /**
- * @brief Fast convert unsigned decimal number to hex string.
+ * @brief Write unsigned number as hex string to the buffer.
  *
+ * @param[out] out - output buffer, must fit sizeof(T) * 2 + 2 characters
  * @param[in] num - number to convert
  * @param[in] usePrefix - add prefix before value (0x)
  *
- * @return hex number string
+ * @return pointer to the end of written text, the text is not
+ *         null-terminated
  */
 template <typename T>
-static std::string toHex(T num, bool usePrefix = true)
+static char* writeHex(char* out, T num, bool usePrefix = true)
 {
-    static const char prefix[] = {'0', 'x'};
     static const char hexMap[] = {'0', '1', '2', '3', '4', '5', '6', '7',
                                   '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
 
-    std::string buf(
-        sizeof(T) * 2 /* hex data */ + (usePrefix ? sizeof(prefix) : 0), 0);
-    char* ptr = buf.data();
-
     if (usePrefix)
     {
-        for (size_t i = 0; i < sizeof(prefix); ++i)
-            *ptr++ = prefix[i];
+        *out++ = '0';
+        *out++ = 'x';
     }
 
     for (size_t i = sizeof(T); i; --i)
     {
         const uint8_t byte = num >> ((i - 1) * 8 /* bits per byte */);
-        *ptr++ = hexMap[byte >> 4];
-        *ptr++ = hexMap[byte & 0x0f];
+        *out++ = hexMap[byte >> 4];
+        *out++ = hexMap[byte & 0x0f];
     }
 
+    return out;
+}
+
+/**
+ * @brief Fast convert unsigned decimal number to hex string.
+ *
+ * @param[in] num - number to convert
+ * @param[in] usePrefix - add prefix before value (0x)
+ *
+ * @return hex number string
+ */
+template <typename T>
+static std::string toHex(T num, bool usePrefix = true)
+{
+    std::string buf(sizeof(T) * 2 /* hex data */ + (usePrefix ? 2 : 0), 0);
+    writeHex(buf.data(), num, usePrefix);
     return buf;
 }
 
+/**
+ * @brief Get size of hex dump.
+ *
+ * @param[in] len - size of source buffer
+ * @param[in] offset - add offset (address) info to dump
+ * @param[in] ascii - add ASCII view to dump
+ *
+ * @return size of hex dump text in bytes
+ */
+size_t hexDumpSize(size_t len, bool offset = true, bool ascii = true);
+
+/**
+ * @brief Write hex dump to the output buffer.
+ *        The buffer must have space for at least hexDumpSize() bytes, the
+ *        dump is not null-terminated.
+ *
+ * @param[out] out - output buffer
+ * @param[in] data - source data buffer
+ * @param[in] len - size of source buffer
+ * @param[in] offset - add offset (address) info to dump
+ * @param[in] ascii - add ASCII view to dump
+ *
+ * @return pointer to the end of hex dump in the output buffer
+ */
+char* hexDump(char* out, const void* data, size_t len, bool offset = true,
+              bool ascii = true);
+
+/**
+ * @brief Append hex dump to the string.
+ *
+ * @param[in,out] out - string to append
+ * @param[in] data - source data buffer
+ * @param[in] len - size of source buffer
+ * @param[in] offset - add offset (address) info to dump
+ * @param[in] ascii - add ASCII view to dump
+ */
+void appendHexDump(std::string& out, const void* data, size_t len,
+                   bool offset = true, bool ascii = true);
+
 /**
  * @brief Create hex dump.
  *
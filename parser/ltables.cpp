@@ -27,7 +27,7 @@ namespace eSEL
 
 // clang-format off
 
-const LookupTable<uint8_t> SubsystemName = {
+constexpr LookupTable<uint8_t> SubsystemName = {
     { 0x00, "Not Applicable" },
     { 0x10, "Processor subsystem" },
     { 0x11, "Processor FRU" },
@@ -118,7 +118,7 @@ const LookupTable<uint8_t> SubsystemName = {
     { 0xa3, "User error" }
 };
 
-const LookupTable<uint8_t> CreatorSubSys = {
+constexpr LookupTable<uint8_t> CreatorSubSys = {
     { 'C', "Hardware Mangagement Console" },
     { 'E', "FipS Error Logger" },
     { 'H', "Hypervisor" },
@@ -132,7 +132,7 @@ const LookupTable<uint8_t> CreatorSubSys = {
     { 'P', "POWERNV" }
 };
 
-const LookupTable<uint8_t> EventSeverity = {
+constexpr LookupTable<uint8_t> EventSeverity = {
     { 0x00, "Informational Event" },
     { 0x10, "Recoverable Error" },
     { 0x20, "Predictive Error" },
@@ -160,14 +160,14 @@ const LookupTable<uint8_t> EventSeverity = {
     { 0x76, "Symptom diagnosis error" }
 };
 
-const LookupTable<uint8_t> EventScope = {
+constexpr LookupTable<uint8_t> EventScope = {
     { 0x01, "Single partition" },
     { 0x02, "Multiple partitions" },
     { 0x03, "Single platform" },
     { 0x04, "Possibly multiple platforms" }
 };
 
-const LookupTable<uint8_t> EventType = {
+constexpr LookupTable<uint8_t> EventType = {
     { 0x00, "Not applicable" },
     { 0x01, "Miscellaneous, informational only." },
     { 0x02, "Tracing event" },
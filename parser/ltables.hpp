@@ -24,7 +24,11 @@
 
 #include "hexdump.hpp"
 
-#include <map>
+#include <array>
+#include <initializer_list>
+#include <limits>
+#include <string_view>
+#include <utility>
 
 namespace eSEL
 {
@@ -32,12 +36,46 @@ namespace eSEL
 /**
  * @class LookupTable
  * @brief Map of ID->Text pairs.
+ *        Table is a dense array indexed by ID, it is built at compile time.
  */
 template <typename T>
-class LookupTable : public std::map<T, const char*>
+class LookupTable
 {
+    static_assert(std::numeric_limits<T>::is_integer && sizeof(T) == 1,
+                  "Dense lookup table requires a single-byte key");
+
   public:
-    using std::map<T, const char*>::map;
+    /** @brief Table entry: ID and its text. */
+    using Entry = std::pair<T, const char*>;
+
+    /**
+     * @brief Constructor.
+     *        If the same ID occurs several times, the first entry is used.
+     *
+     * @param[in] entries - table entries
+     */
+    constexpr LookupTable(std::initializer_list<Entry> entries) : values_{}
+    {
+        for (const Entry& it : entries)
+        {
+            const size_t index = static_cast<uint8_t>(it.first);
+            if (!values_[index])
+                values_[index] = it.second;
+        }
+    }
+
+    /**
+     * @brief Find value in the table.
+     *
+     * @param[in] key - key to search
+     *
+     * @return text value, empty view if key not found
+     */
+    constexpr std::string_view find(T key) const
+    {
+        const char* val = values_[static_cast<uint8_t>(key)];
+        return val ? std::string_view(val) : std::string_view();
+    }
 
     /**
      * @brief Get value from the table.
@@ -51,9 +89,9 @@ class LookupTable : public std::map<T, const char*>
     {
         std::string val;
 
-        auto it = this->find(key);
-        if (it != this->end())
-            val = it->second;
+        const std::string_view found = find(key);
+        if (!found.empty())
+            val = found;
         else if (defValue)
         {
             val = defValue;
@@ -64,6 +102,10 @@ class LookupTable : public std::map<T, const char*>
 
         return val;
     }
+
+  private:
+    /** @brief Text values indexed by ID, null if ID is unknown. */
+    std::array<const char*, std::numeric_limits<uint8_t>::max() + 1> values_;
 };
 
 /** @brief Subsystems names. */
@@ -0,0 +1,134 @@
+/**
+ * @brief Pool of interned parameter names.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "name_pool.hpp"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace eSEL
+{
+
+/** @brief Size limit of names kept by a single storage in bytes. */
+static constexpr size_t StorageLimit = 1024 * 1024;
+
+/**
+ * @struct NameStorage
+ * @brief Storage of interned names, single generation of the pool.
+ */
+struct NameStorage
+{
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] gen - generation number
+     */
+    explicit NameStorage(uint64_t gen) : generation(gen), size(0)
+    {
+    }
+
+    /** @brief Generation number, unique for each storage. */
+    const uint64_t generation;
+    /** @brief Names storage, deque doesn't move elements on growth. */
+    std::deque<std::string> names;
+    /** @brief Index of names, keys refer to the storage. */
+    std::unordered_set<std::string_view> index;
+    /** @brief Lock for names and index. */
+    std::mutex mutex;
+    /** @brief Total size of names in bytes. */
+    std::atomic<size_t> size;
+};
+
+/**
+ * @struct NameCache
+ * @brief Thread local cache of names interned in the same storage.
+ */
+struct NameCache
+{
+    /** @brief Generation of the storage, 0 if the cache is empty. */
+    uint64_t generation = 0;
+    /** @brief Interned names, refer to the storage. */
+    std::unordered_set<std::string_view> names;
+};
+
+/** @brief Cache of the current thread. */
+static thread_local NameCache Cache;
+
+/**
+ * @brief Get storage for new names.
+ *        New storage is started if the current one is full.
+ *
+ * @return storage reference
+ */
+static NameStorageRef acquireStorage()
+{
+    static NameStorageRef current = std::make_shared<NameStorage>(1);
+    static std::mutex mutex;
+
+    NameStorageRef storage = std::atomic_load(&current);
+    if (storage->size.load(std::memory_order_relaxed) < StorageLimit)
+        return storage;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Storage could be replaced by another thread while waiting the lock
+    storage = std::atomic_load(&current);
+    if (storage->size.load(std::memory_order_relaxed) >= StorageLimit)
+    {
+        storage = std::make_shared<NameStorage>(storage->generation + 1);
+        std::atomic_store(&current, storage);
+    }
+    return storage;
+}
+
+std::string_view internName(std::string_view name, NameStorageRef& storage)
+{
+    if (!storage)
+        storage = acquireStorage();
+
+    // Cached names are valid only while their storage is referenced
+    if (Cache.generation != storage->generation)
+    {
+        Cache.names.clear();
+        Cache.generation = storage->generation;
+    }
+    const auto cached = Cache.names.find(name);
+    if (cached != Cache.names.end())
+        return *cached;
+
+    std::string_view interned;
+    {
+        std::lock_guard<std::mutex> lock(storage->mutex);
+        const auto it = storage->index.find(name);
+        if (it != storage->index.end())
+            interned = *it;
+        else
+        {
+            interned = storage->names.emplace_back(name);
+            storage->index.insert(interned);
+            storage->size += name.size();
+        }
+    }
+    Cache.names.insert(interned);
+
+    return interned;
+}
+
+} // namespace eSEL
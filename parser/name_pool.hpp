@@ -0,0 +1,49 @@
+/**
+ * @brief Pool of interned parameter names.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+namespace eSEL
+{
+
+/** @brief Storage of interned names, see name_pool.cpp. */
+struct NameStorage;
+
+/** @brief Reference to the storage of interned names, keeps them alive. */
+using NameStorageRef = std::shared_ptr<NameStorage>;
+
+/**
+ * @brief Intern the name in the global pool.
+ *        The pool is thread-safe, names already used by the calling thread
+ *        are found in its own cache without locking. The pool is split into
+ *        generations: when the current storage exceeds its size limit, the
+ *        next empty reference gets a new storage, the old one is released
+ *        with the last reference to it.
+ *
+ * @param[in] name - name to intern
+ * @param[in,out] storage - storage that keeps the name, the current one is
+ *                          taken if the reference is empty
+ *
+ * @return interned name, valid while the storage is referenced
+ */
+std::string_view internName(std::string_view name, NameStorageRef& storage);
+
+} // namespace eSEL
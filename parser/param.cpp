@@ -25,59 +25,135 @@
 namespace eSEL
 {
 
-Param::Param() : Param(Blank, std::string(), 0U)
+/**
+ * @brief Copy or move variant value, strings are reallocated by the allocator.
+ *
+ * @param[in] value - source value
+ * @param[in] alloc - allocator of string value
+ *
+ * @return variant value
+ */
+template <typename V>
+static Param::variant_t rebindValue(V&& value,
+                                    const Param::allocator_type& alloc)
+{
+    return std::visit(
+        [&alloc](auto&& arg) {
+            using T = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<T, std::pmr::string>)
+            {
+                return Param::variant_t(std::in_place_type<T>,
+                                        std::forward<decltype(arg)>(arg),
+                                        alloc);
+            }
+            else
+                return Param::variant_t(arg);
+        },
+        std::forward<V>(value));
+}
+
+Param::Param() : Param(Blank, ParamName(), 0U)
 {
 }
 
-Param::Param(const std::string& title) : Param(Header, std::string(), title)
+Param::Param(const allocator_type& alloc) :
+    Param(Blank, ParamName(), 0U, alloc)
 {
 }
 
-Param::Param(const std::string& paramName, bool paramValue) :
-    Param(Boolean, paramName, paramValue)
+Param::Param(const std::string& title,
+             const allocator_type& alloc /*= {}*/) :
+    Param(Header, ParamName(), title, alloc)
 {
 }
 
-Param::Param(const std::string& paramName, const std::string& paramValue) :
-    Param(String, paramName, paramValue)
+Param::Param(ParamName paramName, bool paramValue,
+             const allocator_type& alloc /*= {}*/) :
+    Param(Boolean, std::move(paramName), paramValue, alloc)
 {
 }
 
-Param::Param(const std::string& paramName, const char* paramValue) :
-    Param(String, paramName, std::string(paramValue ? paramValue : ""))
+Param::Param(ParamName paramName, const std::string& paramValue,
+             const allocator_type& alloc /*= {}*/) :
+    Param(String, std::move(paramName), paramValue, alloc)
+{
+}
+
+Param::Param(ParamName paramName, std::string_view paramValue,
+             const allocator_type& alloc /*= {}*/) :
+    Param(String, std::move(paramName), paramValue, alloc)
+{
+}
+
+Param::Param(ParamName paramName, const char* paramValue,
+             const allocator_type& alloc /*= {}*/) :
+    Param(String, std::move(paramName),
+          std::string_view(paramValue ? paramValue : ""), alloc)
 {
     // Trim spaces from end of parameter value
-    std::string& val = std::get<std::string>(value_);
+    std::pmr::string& val = std::get<std::pmr::string>(value_);
     val.erase(std::find_if(val.rbegin(), val.rend(),
                            [](int ch) { return !std::isspace(ch); })
                   .base(),
               val.end());
 }
 
+Param::Param(const Param& other, const allocator_type& alloc) :
+    type_(other.type_), name_(other.name_),
+    value_(rebindValue(other.value_, alloc))
+{
+}
+
+Param::Param(Param&& other, const allocator_type& alloc) :
+    type_(other.type_), name_(other.name_),
+    value_(rebindValue(std::move(other.value_), alloc))
+{
+}
+
 Param::Type Param::type() const
 {
     return type_;
 }
 
-const std::string& Param::name() const
+std::string_view Param::name() const
 {
-    return name_;
+    return name_.str();
 }
 
 std::string Param::value() const
 {
-    std::string val;
+    char buf[RenderBufSize];
+    return std::string(render(buf));
+}
+
+void Param::appendValue(std::string& out) const
+{
+    char buf[RenderBufSize];
+    out += render(buf);
+}
+
+size_t Param::formatTo(char* buf, size_t size) const
+{
+    char numBuf[RenderBufSize];
+    const std::string_view val = render(numBuf);
+    val.copy(buf, std::min(size, val.size()));
+    return val.size();
+}
+
+std::string_view Param::render(char* buf) const
+{
+    std::string_view val;
 
     if (type_ != Blank)
     {
         std::visit(
-            [&val](auto&& arg) {
+            [&val, buf](auto&& arg) {
                 using T = std::decay_t<decltype(arg)>;
                 if constexpr (std::is_same_v<T, bool>)
                     val = arg ? "True" : "False";
                 else if constexpr (std::is_arithmetic<T>::value)
-                    val = toHex(arg);
-                else if constexpr (std::is_same_v<T, std::string>)
+                    val = std::string_view(buf, writeHex(buf, arg) - buf);
+                else if constexpr (std::is_same_v<T, std::pmr::string>)
                     val = arg;
                 else
                     static_assert(T::value, "Unhandled value type");
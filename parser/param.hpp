@@ -18,16 +18,82 @@
 
 #pragma once
 
+#include "name_pool.hpp"
+
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
 namespace eSEL
 {
 
+/**
+ * @class ParamName
+ * @brief Name of the parameter.
+ *        Names from string literals are referenced without copying, names
+ *        built at runtime are interned in the global pool.
+ */
+class ParamName
+{
+  public:
+    /**
+     * @brief Constructor for empty name.
+     */
+    ParamName() = default;
+
+    /**
+     * @brief Constructor for static name.
+     *
+     * @param[in] literal - string literal, must outlive the name
+     */
+    template <size_t N>
+    ParamName(const char (&literal)[N]) :
+        name_(literal, std::char_traits<char>::length(literal))
+    {
+    }
+
+    /**
+     * @brief Non-constant arrays are not static, interned names must be
+     *        used for them.
+     */
+    template <size_t N>
+    ParamName(char (&)[N]) = delete;
+
+    /**
+     * @brief Constructor for dynamic name, the name is interned.
+     *
+     * @param[in] name - name to intern
+     * @param[in,out] storage - storage of interned names, must be kept while
+     *                          the name is used
+     */
+    ParamName(std::string_view name, NameStorageRef& storage) :
+        name_(internName(name, storage))
+    {
+    }
+
+    /**
+     * @brief Get name as a string.
+     *
+     * @return name
+     */
+    std::string_view str() const
+    {
+        return name_;
+    }
+
+  private:
+    /** @brief Name: string literal or interned name. */
+    std::string_view name_;
+};
+
 /**
  * @class Param
  * @brief Typed section parameter (name : value).
+ *        String values are allocated by the parameter's allocator, so
+ *        parameters of a section can share its memory resource.
  */
 class Param
 {
@@ -46,8 +112,11 @@ class Param
         String   ///< String type
     };
 
-    using variant_t =
-        std::variant<bool, uint8_t, uint16_t, uint32_t, uint64_t, std::string>;
+    using variant_t = std::variant<bool, uint8_t, uint16_t, uint32_t,
+                                   uint64_t, std::pmr::string>;
+
+    /** @brief Allocator of string values. */
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
 
     /**
      * @brief Base constructor.
@@ -55,10 +124,13 @@ class Param
      * @param[in] paramType - parameter type
      * @param[in] paramName - parameter name
      * @param[in] paramValue - parameter value
+     * @param[in] alloc - allocator of string value
      */
     template <typename T>
-    Param(Type paramType, const std::string& paramName, const T& paramValue) :
-        type_(paramType), name_(paramName), value_(paramValue)
+    Param(Type paramType, ParamName paramName, const T& paramValue,
+          const allocator_type& alloc = {}) :
+        type_(paramType), name_(std::move(paramName)),
+        value_(makeValue(paramValue, alloc))
     {
     }
 
@@ -67,49 +139,96 @@ class Param
      */
     Param();
 
+    /**
+     * @brief Constructor for blank type.
+     *
+     * @param[in] alloc - allocator of string value
+     */
+    explicit Param(const allocator_type& alloc);
+
     /**
      * @brief Constructor for heading type.
      *
      * @param[in] title - heading title
+     * @param[in] alloc - allocator of string value
      */
-    Param(const std::string& title);
+    Param(const std::string& title, const allocator_type& alloc = {});
 
     /**
      * @brief Constructor for boolean type.
      *
      * @param[in] paramName - parameter name
      * @param[in] paramValue - parameter value
+     * @param[in] alloc - allocator of string value
+     */
+    Param(ParamName paramName, bool paramValue,
+          const allocator_type& alloc = {});
+
+    /**
+     * @brief Constructor for string type.
+     *
+     * @param[in] paramName - parameter name
+     * @param[in] paramValue - parameter value
+     * @param[in] alloc - allocator of string value
      */
-    Param(const std::string& paramName, bool paramValue);
+    Param(ParamName paramName, const std::string& paramValue,
+          const allocator_type& alloc = {});
 
     /**
      * @brief Constructor for string type.
      *
      * @param[in] paramName - parameter name
      * @param[in] paramValue - parameter value
+     * @param[in] alloc - allocator of string value
      */
-    Param(const std::string& paramName, const std::string& paramValue);
+    Param(ParamName paramName, const char* paramValue,
+          const allocator_type& alloc = {});
 
     /**
      * @brief Constructor for string type.
      *
      * @param[in] paramName - parameter name
      * @param[in] paramValue - parameter value
+     * @param[in] alloc - allocator of string value
      */
-    Param(const std::string& paramName, const char* paramValue);
+    Param(ParamName paramName, std::string_view paramValue,
+          const allocator_type& alloc = {});
 
     /**
      * @brief Constructor for numeric types.
      *
      * @param[in] paramName - parameter name
      * @param[in] paramValue - parameter value
+     * @param[in] alloc - allocator of string value
      */
     template <typename T>
-    Param(const std::string& paramName, T paramValue) :
-        Param(Numeric, paramName, paramValue)
+    Param(ParamName paramName, T paramValue,
+          const allocator_type& alloc = {}) :
+        Param(Numeric, std::move(paramName), paramValue, alloc)
     {
     }
 
+    /**
+     * @brief Copy constructor with allocator.
+     *
+     * @param[in] other - parameter to copy
+     * @param[in] alloc - allocator of string value
+     */
+    Param(const Param& other, const allocator_type& alloc);
+
+    /**
+     * @brief Move constructor with allocator.
+     *
+     * @param[in] other - parameter to move
+     * @param[in] alloc - allocator of string value
+     */
+    Param(Param&& other, const allocator_type& alloc);
+
+    Param(const Param&) = default;
+    Param(Param&&) = default;
+    Param& operator=(const Param&) = default;
+    Param& operator=(Param&&) = default;
+
     /**
      * @brief Get general parameter type.
      *
@@ -119,10 +238,11 @@ class Param
 
     /**
      * @brief Get parameter name.
+     *        Interned names of decoded parameters are kept by the section.
      *
      * @return parameter name
      */
-    const std::string& name() const;
+    std::string_view name() const;
 
     /**
      * @brief Get parameter value as a string.
@@ -131,6 +251,25 @@ class Param
      */
     std::string value() const;
 
+    /**
+     * @brief Append parameter value as a string to the buffer.
+     *
+     * @param[in,out] out - buffer to append
+     */
+    void appendValue(std::string& out) const;
+
+    /**
+     * @brief Write parameter value as a string to the buffer.
+     *        Value is truncated if buffer is too small, the text is not
+     *        null-terminated.
+     *
+     * @param[out] buf - output buffer
+     * @param[in] size - size of the output buffer in bytes
+     *
+     * @return full length of the value, may be greater than buffer size
+     */
+    size_t formatTo(char* buf, size_t size) const;
+
     /**
      * @brief Get parameter value as raw variant.
      *
@@ -138,16 +277,50 @@ class Param
      */
     const variant_t& variant() const;
 
+  private:
+    /**
+     * @brief Make variant value, strings are allocated by the allocator.
+     *
+     * @param[in] value - source value
+     * @param[in] alloc - allocator of string value
+     *
+     * @return variant value
+     */
+    template <typename T>
+    static variant_t makeValue(const T& value, const allocator_type& alloc)
+    {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>)
+        {
+            const std::string_view str(value);
+            return variant_t(std::in_place_type<std::pmr::string>, str.data(),
+                             str.size(), alloc);
+        }
+        else
+            return variant_t(value);
+    }
+
+    /** @brief Size of buffer to render any numeric value. */
+    static constexpr size_t RenderBufSize = 2 + sizeof(uint64_t) * 2;
+
+    /**
+     * @brief Render value as a string without memory allocation.
+     *
+     * @param[in] buf - buffer for numeric values, RenderBufSize bytes
+     *
+     * @return text value, refers to the buffer or to the parameter's data
+     */
+    std::string_view render(char* buf) const;
+
   private:
     /** @brief Parameter type. */
     Type type_;
     /** @brief Parameter name. */
-    std::string name_;
+    ParamName name_;
     /** @brief Parameter value. */
     variant_t value_;
 };
 
 /** @brief Section parameters array. */
-using Params = std::vector<Param>;
+using Params = std::pmr::vector<Param>;
 
 } // namespace eSEL
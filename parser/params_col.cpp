@@ -26,7 +26,8 @@
 namespace eSEL
 {
 
-ParamsCollector::ParamsCollector(Params& dst) : params_(dst)
+ParamsCollector::ParamsCollector(Params& dst, NameStorageRef& names) :
+    params_(dst), names_(names)
 {
 }
 
@@ -45,12 +46,12 @@ void ParamsCollector::PrintString(const char* name, const char* value)
         val.assign(value, value + pos);
     }
 
-    params_.emplace_back(Param{name, value});
+    params_.emplace_back(makeName(name), value);
 }
 
 void ParamsCollector::PrintBool(const char* name, bool value)
 {
-    params_.emplace_back(Param{name, value});
+    params_.emplace_back(makeName(name), value);
 }
 
 void ParamsCollector::PrintNumber(const char* name, const char* fmt,
@@ -63,7 +64,7 @@ void ParamsCollector::PrintNumber(const char* name, const char* fmt,
         {
             std::string txt(static_cast<size_t>(len) + 1 /* last null */, 0);
             txt.resize(snprintf(txt.data(), txt.size(), fmt, value));
-            params_.emplace_back(Param{name, txt});
+            params_.emplace_back(makeName(name), txt);
         }
     }
 }
@@ -78,14 +79,14 @@ void ParamsCollector::PrintNumberUint64(const char* name, const char* fmt,
         {
             std::string txt(static_cast<size_t>(len) + 1 /* last null */, 0);
             txt.resize(snprintf(txt.data(), txt.size(), fmt, value));
-            params_.emplace_back(Param{name, txt});
+            params_.emplace_back(makeName(name), txt);
         }
     }
 }
 
 void ParamsCollector::PrintHexDump(const void* data, uint32_t len)
 {
-    params_.emplace_back(Param(Param::Raw, std::string(), hexDump(data, len)));
+    params_.emplace_back(Param::Raw, ParamName(), hexDump(data, len));
 }
 
 void ParamsCollector::PrintHeading(const char* name)
@@ -95,12 +96,12 @@ void ParamsCollector::PrintHeading(const char* name)
 
 void ParamsCollector::PrintBlank()
 {
-    params_.emplace_back(Param());
+    params_.emplace_back();
 }
 
 void ParamsCollector::PrintTrace(const char* trace)
 {
-    params_.emplace_back(Param(Param::Raw, std::string(), std::string(trace)));
+    params_.emplace_back(Param::Raw, ParamName(), std::string_view(trace));
 }
 
 bool ParamsCollector::SaveNumeric(const char* name, const char* fmt,
@@ -110,16 +111,25 @@ bool ParamsCollector::SaveNumeric(const char* name, const char* fmt,
         return false; // Space in format - it is a string
 
     // Save in a minimum allowed capacity or capacity specified in format
+    ParamName paramName = makeName(name);
     if (value > std::numeric_limits<uint32_t>::max() || strstr(fmt, "16"))
-        params_.emplace_back(Param{name, value});
+        params_.emplace_back(std::move(paramName), value);
     else if (value > std::numeric_limits<uint16_t>::max() || strchr(fmt, '8'))
-        params_.emplace_back(Param{name, static_cast<uint32_t>(value)});
+        params_.emplace_back(std::move(paramName),
+                             static_cast<uint32_t>(value));
     else if (value > std::numeric_limits<uint8_t>::max() || strchr(fmt, '4'))
-        params_.emplace_back(Param{name, static_cast<uint16_t>(value)});
+        params_.emplace_back(std::move(paramName),
+                             static_cast<uint16_t>(value));
     else
-        params_.emplace_back(Param{name, static_cast<uint8_t>(value)});
+        params_.emplace_back(std::move(paramName),
+                             static_cast<uint8_t>(value));
 
     return true;
 }
 
+ParamName ParamsCollector::makeName(const char* name)
+{
+    return ParamName(name ? name : "", names_);
+}
+
 } // namespace eSEL
@@ -36,8 +36,9 @@ class ParamsCollector : public ErrlUsrParser
      * @brief Constructor.
      *
      * @param[in] dst - parameters array to fill
+     * @param[in,out] names - storage of interned names of the parameters
      */
-    ParamsCollector(Params& dst);
+    ParamsCollector(Params& dst, NameStorageRef& names);
 
     // From ErrlUsrParser
     void PrintString(const char* name, const char* value) override;
@@ -65,9 +66,22 @@ class ParamsCollector : public ErrlUsrParser
      */
     bool SaveNumeric(const char* name, const char* fmt, uint64_t value);
 
+  private:
+    /**
+     * @brief Make parameter name from the plugin's label.
+     *        Plugins may build labels at runtime, so the name is interned.
+     *
+     * @param[in] name - label passed by the plugin, may be nullptr
+     *
+     * @return parameter name
+     */
+    ParamName makeName(const char* name);
+
   private:
     /** @brief Collected parameters. */
     Params& params_;
+    /** @brief Storage of interned names. */
+    NameStorageRef& names_;
 };
 
 } // namespace eSEL
@@ -0,0 +1,63 @@
+/**
+ * @brief Status of eSEL parsing.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parse_status.hpp"
+
+#include "fmtexcept.hpp"
+
+namespace eSEL
+{
+
+const char* describe(ParseError error) noexcept
+{
+    switch (error)
+    {
+        case ParseError::None:
+            return "No errors";
+        case ParseError::InvalidBuffer:
+            return "Invalid input buffer";
+        case ParseError::BufferTooSmall:
+            return "eSEL buffer too small";
+        case ParseError::NoPrivateHeader:
+            return "Private Header section not found";
+        case ParseError::HeaderTooSmall:
+            return "Input buffer is smaller than section header";
+        case ParseError::SectionTooSmall:
+            return "Section length is too small";
+        case ParseError::SectionOverflow:
+            return "Section length is bigger than buffer size";
+        case ParseError::PayloadSize:
+            return "Incompatible section payload size";
+        case ParseError::UnexpectedEnd:
+            return "Unexpected buffer end";
+        case ParseError::OutOfMemory:
+            return "Not enough memory";
+    }
+    return "Unknown error";
+}
+
+void throwOnError(const ParseStatus& status)
+{
+    if (!status)
+    {
+        throw InvalidFormat("%s at offset %zu", describe(status.error),
+                            status.offset);
+    }
+}
+
+} // namespace eSEL
@@ -0,0 +1,82 @@
+/**
+ * @brief Status of eSEL parsing.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace eSEL
+{
+
+/**
+ * @enum ParseError
+ * @brief Parsing error codes.
+ */
+enum class ParseError
+{
+    None,            ///< No errors
+    InvalidBuffer,   ///< Invalid input buffer (null pointer)
+    BufferTooSmall,  ///< Buffer too small to fit eSEL
+    NoPrivateHeader, ///< Private Header section not found
+    HeaderTooSmall,  ///< Buffer is smaller than section header
+    SectionTooSmall, ///< Section length is smaller than its header
+    SectionOverflow, ///< Section length is bigger than buffer
+    PayloadSize,     ///< Incompatible section payload size
+    UnexpectedEnd,   ///< Buffer ends before the last section
+    OutOfMemory      ///< Memory allocation failed
+};
+
+/**
+ * @struct ParseStatus
+ * @brief Result of parsing: error code and its position.
+ */
+struct ParseStatus
+{
+    ParseError error; ///< Error code
+    size_t offset;    ///< Offset of the error in the source buffer
+
+    /**
+     * @brief Check for success.
+     *
+     * @return true if there are no errors
+     */
+    explicit operator bool() const noexcept
+    {
+        return error == ParseError::None;
+    }
+};
+
+/**
+ * @brief Get description of the error code.
+ *
+ * @param[in] error - error code
+ *
+ * @return error description
+ */
+const char* describe(ParseError error) noexcept;
+
+/**
+ * @brief Throw InvalidFormat exception if status contains error.
+ *
+ * @param[in] status - status to check
+ *
+ * @throws InvalidFormat if status contains error
+ */
+void throwOnError(const ParseStatus& status);
+
+} // namespace eSEL
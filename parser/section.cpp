@@ -20,13 +20,52 @@
 
 #include "ltables.hpp"
 
+#include <endian.h>
+
+#include <cstring>
 #include <hbplugins.hpp>
 
 namespace eSEL
 {
 
-Section::Section(const Header& header, const Payload& payload) :
-    header_(header), payload_(payload)
+Section::Header Section::readHeader(const uint8_t* data, size_t len,
+                                    size_t offset /*= 0*/)
+{
+    Header header;
+    throwOnError({readHeader(data, len, header), offset});
+    return header;
+}
+
+ParseError Section::readHeader(const uint8_t* data, size_t len,
+                               Header& header) noexcept
+{
+    if (len <= sizeof(Header))
+        return ParseError::HeaderTooSmall;
+
+    memcpy(&header, data, sizeof(header));
+    header.id = be16toh(header.id);
+    header.length = be16toh(header.length);
+    header.component = be16toh(header.component);
+
+    if (header.length <= sizeof(Header))
+        return ParseError::SectionTooSmall;
+    if (header.length > len)
+        return ParseError::SectionOverflow;
+
+    return ParseError::None;
+}
+
+Section::Section(const Header& header, Payload payload) :
+    header_(header), payload_(std::move(payload)), decoded_(false),
+    params_(payload_.get_allocator().resource())
+{
+}
+
+Section::Section(Section&& other) noexcept :
+    header_(other.header_), payload_(std::move(other.payload_)),
+    names_(std::move(other.names_)), decoded_(other.decoded_.load()),
+    params_(std::move(other.params_)),
+    diagnostics_(std::move(other.diagnostics_))
 {
 }
 
@@ -65,9 +104,36 @@ const Section::Payload& Section::payload() const
     return payload_;
 }
 
-Params Section::payloadParams() const
+const Params& Section::payloadParams() const
 {
+    if (!decoded_.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(decodeMutex_);
+        if (!decoded_.load(std::memory_order_relaxed))
+        {
+            // Decode to a temporary array to get nothing on exception
+            Params params(params_.get_allocator());
+            Diagnostics diagnostics;
+            decodePayload(params, diagnostics);
+            params_ = std::move(params);
+            diagnostics_ = std::move(diagnostics);
+            decoded_.store(true, std::memory_order_release);
+        }
+    }
     return params_;
 }
 
+const Diagnostics& Section::diagnostics() const
+{
+    static const Diagnostics notDecoded;
+    return decoded_.load(std::memory_order_acquire) ? diagnostics_
+                                                    : notDecoded;
+}
+
+void Section::decodePayload(Params& /*params*/,
+                            Diagnostics& /*diagnostics*/) const
+{
+    // Payload of unknown section type can't be decoded
+}
+
 } // namespace eSEL
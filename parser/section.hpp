@@ -19,15 +19,29 @@
 #pragma once
 
 #include "param.hpp"
+#include "parse_status.hpp"
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace eSEL
 {
 
+/**
+ * @struct Diagnostics
+ * @brief Problems found while decoding section's payload.
+ */
+struct Diagnostics
+{
+    std::vector<std::string> errors;   ///< Failures, decoded data is partial
+    std::vector<std::string> warnings; ///< Problems that don't break decoding
+};
+
 /**
  * @class Section
  * @brief Base representation of a eSEL section.
@@ -54,17 +68,49 @@ class Section
         uint16_t component; ///< Component id of section creator
     } __attribute__((packed));
 
-    /** @brief Section payload data buffer */
-    using Payload = std::vector<uint8_t>;
+    /** @brief Section payload data buffer, its memory resource is used for
+     *         decoded parameters too. */
+    using Payload = std::pmr::vector<uint8_t>;
+
+    /** @brief Read and check section header from raw data.
+     *
+     *  @param[in] data - pointer to the section's raw data
+     *  @param[in] len - size of the data buffer in bytes
+     *  @param[in] offset - offset of the section in the event, used in
+     *                      the error description
+     *
+     *  @return section header in host byte order
+     *
+     *  @throws InvalidFormat if buffer doesn't contain a valid section
+     */
+    static Header readHeader(const uint8_t* data, size_t len,
+                             size_t offset = 0);
+
+    /** @brief Read and check section header from raw data.
+     *
+     *  @param[in] data - pointer to the section's raw data
+     *  @param[in] len - size of the data buffer in bytes
+     *  @param[out] header - section header in host byte order
+     *
+     *  @return error code, ParseError::None if the section is valid
+     */
+    static ParseError readHeader(const uint8_t* data, size_t len,
+                                 Header& header) noexcept;
 
     /** @brief Constructor.
      *
      *  @param[in] header - section header
-     *  @param[in] payload - section payload data
+     *  @param[in] payload - section payload data, moved into the instance
      *
      *  @throws InvalidFormat if header or payload contains wrong data
      */
-    Section(const Header& header, const Payload& payload);
+    Section(const Header& header, Payload payload);
+
+    /** @brief Move constructor, decoded payload parameters are moved too.
+     *
+     *  @param[in] other - instance to move from
+     */
+    Section(Section&& other) noexcept;
 
     /** @brief Destructor. */
     virtual ~Section() = default;
@@ -94,21 +140,51 @@ class Section
     const Payload& payload() const;
 
     /** @brief Get human readable description of section's payload.
+     *         The payload is decoded on the first call, the result is
+     *         cached for subsequent calls. Thread safe.
      *
      *  @return array of human readable parameters of section's payload
      */
-    Params payloadParams() const;
+    const Params& payloadParams() const;
+
+    /** @brief Get problems found while decoding section's payload.
+     *         The payload is not decoded by this call, nothing is reported
+     *         for the section until its parameters are requested.
+     *
+     *  @return problems description
+     */
+    const Diagnostics& diagnostics() const;
+
+  protected:
+    /** @brief Decode section's payload to human readable parameters.
+     *         Called once on the first request of payload parameters.
+     *
+     *  @param[out] params - array of parameters to fill
+     *  @param[out] diagnostics - problems found while decoding
+     */
+    virtual void decodePayload(Params& params,
+                               Diagnostics& diagnostics) const;
 
   protected:
     /** @brief Section's header. */
     Header header_;
     /** @brief Section's payload data. */
     Payload payload_;
+    /** @brief Storage of interned names of decoded parameters. */
+    mutable NameStorageRef names_;
+
+  private:
+    /** @brief Mutex used to decode payload only once. */
+    mutable std::mutex decodeMutex_;
+    /** @brief Flag: payload decoded, parameters are available. */
+    mutable std::atomic<bool> decoded_;
     /** @brief Human readable section's payload data. */
-    Params params_;
+    mutable Params params_;
+    /** @brief Problems found while decoding payload. */
+    mutable Diagnostics diagnostics_;
 };
 
 // Sections array
-using Sections = std::vector<std::shared_ptr<Section>>;
+using Sections = std::pmr::vector<std::shared_ptr<Section>>;
 
 } // namespace eSEL
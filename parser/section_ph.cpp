@@ -28,8 +28,8 @@
 namespace eSEL
 {
 
-SectionPH::SectionPH(const Header& header, const Payload& payload) :
-    Section(header, payload)
+SectionPH::SectionPH(const Header& header, Payload payload) :
+    Section(header, std::move(payload))
 {
     if (payload_.size() != sizeof(PHData))
     {
@@ -46,16 +46,6 @@ SectionPH::SectionPH(const Header& header, const Payload& payload) :
     data_.creatorSubIdLo = be32toh(data_.creatorSubIdLo);
     data_.platformId = be32toh(data_.platformId);
     data_.logEntryId = be32toh(data_.logEntryId);
-
-    // Construct human readable descriptions
-    params_ = {{"Create timestamp", data_.createTimestamp},
-               {"Commit timestamp", data_.commitTimestamp},
-               {"Creator subsystem", CreatorSubSys.get(data_.subsystemId)},
-               {"Section count", data_.sectionCount},
-               {"Creator ID Lo", data_.creatorSubIdLo},
-               {"Creator ID Hi", data_.creatorSubIdHi},
-               {"Platform log ID", data_.platformId},
-               {"Log entry ID", data_.logEntryId}};
 }
 
 std::string SectionPH::name() const
@@ -63,6 +53,19 @@ std::string SectionPH::name() const
     return "Private header";
 }
 
+void SectionPH::decodePayload(Params& params,
+                               Diagnostics& /*diagnostics*/) const
+{
+    params = {{"Create timestamp", data_.createTimestamp},
+              {"Commit timestamp", data_.commitTimestamp},
+              {"Creator subsystem", CreatorSubSys.get(data_.subsystemId)},
+              {"Section count", data_.sectionCount},
+              {"Creator ID Lo", data_.creatorSubIdLo},
+              {"Creator ID Hi", data_.creatorSubIdHi},
+              {"Platform log ID", data_.platformId},
+              {"Log entry ID", data_.logEntryId}};
+}
+
 const SectionPH::PHData& SectionPH::data() const
 {
     return data_;
@@ -51,7 +51,7 @@ class SectionPH : public Section
         uint32_t logEntryId; ///< Unique log entry id
     } __attribute__((packed));
 
-    SectionPH(const Header& header, const Payload& payload);
+    SectionPH(const Header& header, Payload payload);
     std::string name() const override;
 
     /**
@@ -61,6 +61,10 @@ class SectionPH : public Section
      */
     const PHData& data() const;
 
+  protected:
+    void decodePayload(Params& params,
+                       Diagnostics& diagnostics) const override;
+
   private:
     /** @brief Unflatten section data. */
     PHData data_;
@@ -24,14 +24,15 @@
 
 #include <endian.h>
 
+#include <cctype>
 #include <cinttypes>
 #include <hbplugins.hpp>
 
 namespace eSEL
 {
 
-SectionPS::SectionPS(const Header& header, const Payload& payload) :
-    Section(header, payload)
+SectionPS::SectionPS(const Header& header, Payload payload) :
+    Section(header, std::move(payload))
 {
     if (payload_.size() != sizeof(PSRCData))
     {
@@ -51,51 +52,96 @@ SectionPS::SectionPS(const Header& header, const Payload& payload) :
     data_.extRefCode7 = be32toh(data_.extRefCode7);
     data_.extRefCode8 = be32toh(data_.extRefCode8);
     data_.extRefCode9 = be32toh(data_.extRefCode9);
+}
+
+std::string SectionPS::name() const
+{
+    return "Primary System Reference Code";
+}
+
+/**
+ * @brief Parse hexadecimal number at the beginning of the text.
+ *        Leading spaces and optional "0x" prefix are skipped, like
+ *        std::stoul does, but without throwing exceptions.
+ *
+ * @param[in] text - source text
+ * @param[out] value - parsed value
+ *
+ * @return false if text doesn't start with a valid hexadecimal number
+ */
+static bool parseHex(const std::string& text, uint64_t& value) noexcept
+{
+    size_t pos = 0;
+    while (pos < text.size() &&
+           std::isspace(static_cast<unsigned char>(text[pos])))
+        ++pos;
+    if (text.compare(pos, 2, "0x") == 0 || text.compare(pos, 2, "0X") == 0)
+        pos += 2;
 
-    // Construct human readable descriptions
+    value = 0;
+    size_t digits = 0;
+    for (; pos < text.size(); ++pos, ++digits)
+    {
+        const char ch = text[pos];
+        uint8_t nibble;
+        if (ch >= '0' && ch <= '9')
+            nibble = ch - '0';
+        else if (ch >= 'a' && ch <= 'f')
+            nibble = ch - 'a' + 10;
+        else if (ch >= 'A' && ch <= 'F')
+            nibble = ch - 'A' + 10;
+        else
+            break;
+        if (value >> 60)
+            return false; // overflow
+        value = (value << 4) | nibble;
+    }
+
+    return digits != 0;
+}
+
+void SectionPS::decodePayload(Params& params,
+                               Diagnostics& /*diagnostics*/) const
+{
     std::string rcText(data_.primaryRefCode,
                        data_.primaryRefCode + sizeof(data_.primaryRefCode));
+    uint64_t value;
     uint32_t rcNum = 0;
-    try
+    if (parseHex(rcText, value))
     {
-        rcNum = std::stoul(rcText, 0, 16);
-        params_.emplace_back(
+        rcNum = static_cast<uint32_t>(value);
+        params.emplace_back(
             Param{"Module",
                   getComponentName(static_cast<uint16_t>(rcNum & 0xff00))});
-        params_.emplace_back(Param{"Reference code", rcNum});
+        params.emplace_back(Param{"Reference code", rcNum});
     }
-    catch (const std::exception&)
+    else
     {
-        params_.emplace_back(Param{"Reference code", rcText});
+        params.emplace_back(Param{"Reference code", rcText});
     }
 
     // clang-format off
-    params_.emplace_back(Param{"Flags", data_.flags});
-    params_.emplace_back(Param{"Valid word count", data_.wordCount});
-    params_.emplace_back(Param{"Words 2-5",
-                               toHex(data_.extRefCode2, false) + " " +
-                               toHex(data_.extRefCode3, false) + " " +
-                               toHex(data_.extRefCode4, false) + " " +
-                               toHex(data_.extRefCode5, false)});
-    params_.emplace_back(Param{"Words 6-9",
-                               toHex(data_.extRefCode6, false) + " " +
-                               toHex(data_.extRefCode7, false) + " " +
-                               toHex(data_.extRefCode8, false) + " " +
-                               toHex(data_.extRefCode9, false)});
+    params.emplace_back(Param{"Flags", data_.flags});
+    params.emplace_back(Param{"Valid word count", data_.wordCount});
+    params.emplace_back(Param{"Words 2-5",
+                              toHex(data_.extRefCode2, false) + " " +
+                              toHex(data_.extRefCode3, false) + " " +
+                              toHex(data_.extRefCode4, false) + " " +
+                              toHex(data_.extRefCode5, false)});
+    params.emplace_back(Param{"Words 6-9",
+                              toHex(data_.extRefCode6, false) + " " +
+                              toHex(data_.extRefCode7, false) + " " +
+                              toHex(data_.extRefCode8, false) + " " +
+                              toHex(data_.extRefCode9, false)});
     // clang-format on
 
     if (rcNum)
     {
-        ParamsCollector pc(params_);
+        ParamsCollector pc(params, names_);
         getSourceDescription(pc, rcNum, data_.extRefCode3);
     }
 }
 
-std::string SectionPS::name() const
-{
-    return "Primary System Reference Code";
-}
-
 const SectionPS::PSRCData& SectionPS::data() const
 {
     return data_;
@@ -56,7 +56,7 @@ class SectionPS : public Section
         char primaryRefCode[32];
     } __attribute__((packed));
 
-    SectionPS(const Header& header, const Payload& payload);
+    SectionPS(const Header& header, Payload payload);
     std::string name() const override;
 
     /**
@@ -66,6 +66,10 @@ class SectionPS : public Section
      */
     const PSRCData& data() const;
 
+  protected:
+    void decodePayload(Params& params,
+                       Diagnostics& diagnostics) const override;
+
   private:
     /** @brief Unflatten section data. */
     PSRCData data_;
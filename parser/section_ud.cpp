@@ -26,19 +26,9 @@
 namespace eSEL
 {
 
-SectionUD::SectionUD(const Header& header, const Payload& payload) :
-    Section(header, payload)
+SectionUD::SectionUD(const Header& header, Payload payload) :
+    Section(header, std::move(payload))
 {
-    // Parse section's payload
-    ParamsCollector pc(params_);
-    const bool rc = parseUserDefinedSection(pc, header_.component,
-                                            header_.subtype, header_.version,
-                                            payload_.data(), payload_.size());
-    if (!rc)
-    {
-        std::string hex = hexDump(payload_.data(), payload_.size());
-        params_.emplace_back(Param(Param::Raw, std::string(), std::move(hex)));
-    }
 }
 
 std::string SectionUD::name() const
@@ -46,4 +36,41 @@ std::string SectionUD::name() const
     return "User Defined Data";
 }
 
+void SectionUD::prefetch(const std::vector<const SectionUD*>& sections,
+                         ThreadPool& pool)
+{
+    std::vector<UserDefinedData> data;
+    data.reserve(sections.size());
+    for (const SectionUD* it : sections)
+    {
+        data.push_back({it->header_.component, it->header_.subtype,
+                        it->header_.version, it->payload_.data(),
+                        static_cast<uint32_t>(it->payload_.size())});
+    }
+    prefetchUserDefinedSections(
+        data, [&pool](std::vector<std::function<void()>>& tasks) {
+            std::vector<std::future<void>> results;
+            results.reserve(tasks.size());
+            for (auto& it : tasks)
+                results.emplace_back(pool.submit(std::move(it)));
+            for (auto& it : results)
+                it.get();
+        });
+}
+
+void SectionUD::decodePayload(Params& params,
+                               Diagnostics& diagnostics) const
+{
+    ParamsCollector pc(params, names_);
+    const bool rc = parseUserDefinedSection(
+        pc, header_.component, header_.subtype, header_.version,
+        payload_.data(), payload_.size(), diagnostics.errors,
+        diagnostics.warnings);
+    if (!rc)
+    {
+        std::string hex = hexDump(payload_.data(), payload_.size());
+        params.emplace_back(Param::Raw, ParamName(), hex);
+    }
+}
+
 } // namespace eSEL
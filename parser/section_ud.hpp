@@ -19,6 +19,9 @@
 #pragma once
 
 #include "section.hpp"
+#include "thread_pool.hpp"
+
+#include <vector>
 
 namespace eSEL
 {
@@ -33,8 +36,24 @@ class SectionUD : public Section
     /** @brief Section Id. */
     static constexpr uint16_t SectionId = sectionId('U', 'D');
 
-    SectionUD(const Header& header, const Payload& payload);
+    SectionUD(const Header& header, Payload payload);
     std::string name() const override;
+
+    /**
+     * @brief Prepare decoding of multiple sections.
+     *        Data is decoded natively by the pool workers, data that requires
+     *        an external utility is decoded at once for all sections, so it
+     *        can be done by a single run of the utility.
+     *
+     * @param[in] sections - sections to prepare
+     * @param[in] pool - thread pool for native decoding
+     */
+    static void prefetch(const std::vector<const SectionUD*>& sections,
+                         ThreadPool& pool);
+
+  protected:
+    void decodePayload(Params& params,
+                       Diagnostics& diagnostics) const override;
 };
 
 } // namespace eSEL
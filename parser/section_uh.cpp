@@ -28,8 +28,8 @@
 namespace eSEL
 {
 
-SectionUH::SectionUH(const Header& header, const Payload& payload) :
-    Section(header, payload)
+SectionUH::SectionUH(const Header& header, Payload payload) :
+    Section(header, std::move(payload))
 {
     if (payload_.size() != sizeof(UHData))
     {
@@ -39,15 +39,6 @@ SectionUH::SectionUH(const Header& header, const Payload& payload) :
     }
     data_ = *reinterpret_cast<const UHData*>(payload_.data());
     data_.action = be16toh(data_.action);
-
-    // Construct human readable descriptions
-    params_ = {{"Subsystem", SubsystemName.get(data_.subsystemId)},
-               {"Event severity", EventSeverity.get(data_.eventSeverity)},
-               {"Event type", EventType.get(data_.eventType)},
-               {"Event scope", EventScope.get(data_.eventData)},
-               {"Problem domain", data_.problemDomain},
-               {"Problem vector", data_.problemVector},
-               {"Action", data_.action}};
 }
 
 std::string SectionUH::name() const
@@ -55,6 +46,18 @@ std::string SectionUH::name() const
     return "User Header";
 }
 
+void SectionUH::decodePayload(Params& params,
+                               Diagnostics& /*diagnostics*/) const
+{
+    params = {{"Subsystem", SubsystemName.get(data_.subsystemId)},
+              {"Event severity", EventSeverity.get(data_.eventSeverity)},
+              {"Event type", EventType.get(data_.eventType)},
+              {"Event scope", EventScope.get(data_.eventData)},
+              {"Problem domain", data_.problemDomain},
+              {"Problem vector", data_.problemVector},
+              {"Action", data_.action}};
+}
+
 const SectionUH::UHData& SectionUH::data() const
 {
     return data_;
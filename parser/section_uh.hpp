@@ -49,7 +49,7 @@ class SectionUH : public Section
         uint32_t reserved1;
     } __attribute__((packed));
 
-    SectionUH(const Header& header, const Payload& payload);
+    SectionUH(const Header& header, Payload payload);
     std::string name() const override;
 
     /** @brief Get unflatten section data.
@@ -58,6 +58,10 @@ class SectionUH : public Section
      */
     const UHData& data() const;
 
+  protected:
+    void decodePayload(Params& params,
+                       Diagnostics& diagnostics) const override;
+
   private:
     /** @brief Unflatten section data */
     UHData data_;
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <string>
+
 namespace eSEL
 {
 
@@ -28,6 +30,19 @@ namespace eSEL
  */
 void setHostbootSymbols(const char* symbolsFile);
 
+/**
+ * @brief Build binary index of Hostboot's symbols file.
+ *        The index is saved next to the symbols file with ".symidx" suffix
+ *        and is used instead of the symbols file while it is up to date.
+ *
+ * @param[in] symbolsFile - path to Hostboot's core symbols file
+ *
+ * @return path to the created index file
+ *
+ * @throws std::system_error on errors
+ */
+std::string buildHostbootSymbolsIndex(const char* symbolsFile);
+
 /**
  * @brief Set Hostboot's string file location used by FSP tracer.
  *
@@ -49,4 +64,14 @@ void setOccStrings(const char* stringFile);
  */
 void setFspTrace(const char* path);
 
+/**
+ * @brief Get identity of the decoder setup.
+ *        Identity contains HostBoot revision and paths, sizes and
+ *        modification times of string files, symbols file and FSP trace
+ *        utility, so it changes whenever decoded data may change.
+ *
+ * @return identity description
+ */
+std::string getSetupIdentity();
+
 } // namespace eSEL
@@ -0,0 +1,126 @@
+/**
+ * @brief Short summary of eSEL (OpenPOWER Platform Event Log record).
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "summary.hpp"
+
+#include "section_ph.hpp"
+#include "section_ps.hpp"
+#include "section_uh.hpp"
+#include "sel_record.hpp"
+
+#include <endian.h>
+
+#include <cstring>
+
+namespace eSEL
+{
+
+/** @brief Read section header without throwing exceptions.
+ *
+ *  @param[in] data - pointer to the section's raw data
+ *  @param[in] len - size of the data buffer in bytes
+ *  @param[out] header - section header in host byte order
+ *
+ *  @return false if buffer doesn't contain a valid section
+ */
+static bool peekHeader(const uint8_t* data, size_t len,
+                       Section::Header& header) noexcept
+{
+    return Section::readHeader(data, len, header) == ParseError::None;
+}
+
+EventSummary summarize(const uint8_t* data, size_t len) noexcept
+{
+    EventSummary summary;
+    memset(&summary, 0, sizeof(summary));
+
+    if (!data)
+        return summary;
+
+    // Skip SEL record if it exists
+    size_t pos = 0;
+    Section::Header header;
+    if (!peekHeader(data, len, header) || header.id != SectionPH::SectionId)
+        pos += sizeof(SelRecord);
+
+    // Private Header, always the first section
+    if (pos > len || !peekHeader(data + pos, len - pos, header) ||
+        header.id != SectionPH::SectionId ||
+        header.length != sizeof(header) + sizeof(SectionPH::PHData))
+        return summary;
+    SectionPH::PHData ph;
+    memcpy(&ph, data + pos + sizeof(header), sizeof(ph));
+    summary.valid = true;
+    summary.createTimestamp = be64toh(ph.createTimestamp);
+    summary.commitTimestamp = be64toh(ph.commitTimestamp);
+    summary.creator = ph.subsystemId;
+    summary.sectionCount = ph.sectionCount;
+    summary.platformId = be32toh(ph.platformId);
+    summary.logEntryId = be32toh(ph.logEntryId);
+    pos += header.length;
+
+    // Search for User Header and the first Primary SRC
+    for (size_t i = 1; i < ph.sectionCount &&
+                       (!summary.hasUserHeader || !summary.hasPrimarySrc);
+         ++i)
+    {
+        if (pos >= len || !peekHeader(data + pos, len - pos, header))
+            break;
+        const uint8_t* payload = data + pos + sizeof(header);
+        const size_t payloadLen = header.length - sizeof(header);
+        pos += header.length;
+
+        if (header.id == SectionUH::SectionId && !summary.hasUserHeader &&
+            payloadLen == sizeof(SectionUH::UHData))
+        {
+            SectionUH::UHData uh;
+            memcpy(&uh, payload, sizeof(uh));
+            summary.hasUserHeader = true;
+            summary.subsystem = uh.subsystemId;
+            summary.scope = uh.eventData;
+            summary.severity = uh.eventSeverity;
+            summary.eventType = uh.eventType;
+            summary.action = be16toh(uh.action);
+        }
+        else if (header.id == SectionPS::SectionId && !summary.hasPrimarySrc &&
+                 payloadLen == sizeof(SectionPS::PSRCData))
+        {
+            SectionPS::PSRCData ps;
+            memcpy(&ps, payload, sizeof(ps));
+            summary.hasPrimarySrc = true;
+            // Reference code is padded with spaces
+            size_t rcLen = sizeof(ps.primaryRefCode);
+            while (rcLen && (ps.primaryRefCode[rcLen - 1] == ' ' ||
+                             ps.primaryRefCode[rcLen - 1] == '\0'))
+                --rcLen;
+            memcpy(summary.primaryRefCode, ps.primaryRefCode, rcLen);
+            summary.extRefCode[0] = be32toh(ps.extRefCode2);
+            summary.extRefCode[1] = be32toh(ps.extRefCode3);
+            summary.extRefCode[2] = be32toh(ps.extRefCode4);
+            summary.extRefCode[3] = be32toh(ps.extRefCode5);
+            summary.extRefCode[4] = be32toh(ps.extRefCode6);
+            summary.extRefCode[5] = be32toh(ps.extRefCode7);
+            summary.extRefCode[6] = be32toh(ps.extRefCode8);
+            summary.extRefCode[7] = be32toh(ps.extRefCode9);
+        }
+    }
+
+    return summary;
+}
+
+} // namespace eSEL
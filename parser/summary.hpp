@@ -0,0 +1,70 @@
+/**
+ * @brief Short summary of eSEL (OpenPOWER Platform Event Log record).
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace eSEL
+{
+
+/**
+ * @struct EventSummary
+ * @brief Key fields of eSEL, all numbers are in host byte order.
+ */
+struct EventSummary
+{
+    bool valid;         ///< Private Header found, PH fields are set
+    bool hasUserHeader; ///< User Header found, UH fields are set
+    bool hasPrimarySrc; ///< Primary SRC found, SRC fields are set
+
+    // Private Header
+    uint64_t createTimestamp; ///< Creation timestamp (TB register format)
+    uint64_t commitTimestamp; ///< Commit timestamp (TB register format)
+    uint8_t creator;          ///< Creator subsystem id
+    uint8_t sectionCount;     ///< Number of sections in log
+    uint32_t platformId;      ///< Platform log id
+    uint32_t logEntryId;      ///< Unique log entry id
+
+    // User Header
+    uint8_t subsystem; ///< Subsystem id
+    uint8_t scope;     ///< Event scope
+    uint8_t severity;  ///< Event severity
+    uint8_t eventType; ///< Event type
+    uint16_t action;   ///< Action code
+
+    // Primary System Reference Code
+    char primaryRefCode[33]; ///< Primary reference code, null-terminated
+    uint32_t extRefCode[8];  ///< Extended reference codes (words 2-9)
+};
+
+/**
+ * @brief Get summary of eSEL from raw binary data.
+ *        Only section headers and fixed structures of Private Header, User
+ *        Header and Primary SRC are read: the function doesn't decode
+ *        payloads and doesn't allocate memory.
+ *
+ * @param[in] data - pointer to the data buffer
+ * @param[in] len - size of the data buffer in bytes
+ *
+ * @return event summary, the valid flag is cleared if eSEL is corrupted
+ */
+EventSummary summarize(const uint8_t* data, size_t len) noexcept;
+
+} // namespace eSEL
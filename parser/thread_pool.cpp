@@ -0,0 +1,92 @@
+/**
+ * @brief Pool of worker threads.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace eSEL
+{
+
+ThreadPool::ThreadPool(size_t threads) : stop_(false)
+{
+    if (!threads)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    try
+    {
+        workers_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i)
+            workers_.emplace_back(&ThreadPool::work, this);
+    }
+    catch (...)
+    {
+        // Destroying joinable threads terminates the process
+        stop();
+        throw;
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+size_t ThreadPool::size() const
+{
+    return workers_.size();
+}
+
+void ThreadPool::push(std::function<void()>&& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.emplace(std::move(task));
+    }
+    wakeup_.notify_one();
+}
+
+void ThreadPool::work()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wakeup_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty())
+                return; // stopped and nothing left to do
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+        task();
+    }
+}
+
+void ThreadPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wakeup_.notify_all();
+    for (auto& it : workers_)
+        it.join();
+}
+
+} // namespace eSEL
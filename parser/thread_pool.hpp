@@ -0,0 +1,114 @@
+/**
+ * @brief Pool of worker threads.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace eSEL
+{
+
+/**
+ * @class ThreadPool
+ * @brief Fixed size pool of worker threads executing tasks in FIFO order.
+ */
+class ThreadPool
+{
+  public:
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] threads - number of worker threads, 0 to use the number of
+     *                      available CPU cores
+     */
+    explicit ThreadPool(size_t threads = 0);
+
+    /**
+     * @brief Destructor: waits for completion of all queued tasks.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Get number of worker threads.
+     *
+     * @return number of threads
+     */
+    size_t size() const;
+
+    /**
+     * @brief Queue task for execution.
+     *
+     * @param[in] fn - task to execute
+     *
+     * @return future result of the task, exception thrown by the task is
+     *         passed through the future
+     */
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& fn)
+    {
+        using Result = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(
+            std::forward<F>(fn));
+        std::future<Result> result = task->get_future();
+        push([task]() { (*task)(); });
+        return result;
+    }
+
+  private:
+    /**
+     * @brief Put task to the queue and wake up a worker.
+     *
+     * @param[in] task - task to execute
+     */
+    void push(std::function<void()>&& task);
+
+    /**
+     * @brief Worker thread's loop.
+     */
+    void work();
+
+    /**
+     * @brief Stop started worker threads, queued tasks are finished.
+     */
+    void stop();
+
+  private:
+    /** @brief Worker threads. */
+    std::vector<std::thread> workers_;
+    /** @brief Queue of tasks. */
+    std::queue<std::function<void()>> tasks_;
+    /** @brief Mutex to guard the queue. */
+    std::mutex mutex_;
+    /** @brief Condition to wake up workers. */
+    std::condition_variable wakeup_;
+    /** @brief Stop flag, set by destructor. */
+    bool stop_;
+};
+
+} // namespace eSEL
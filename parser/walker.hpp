@@ -0,0 +1,226 @@
+/**
+ * @brief Walker through sections of eSEL raw data.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "event_view.hpp"
+#include "parse_status.hpp"
+#include "section_ph.hpp"
+#include "section_ps.hpp"
+#include "section_ud.hpp"
+#include "section_uh.hpp"
+#include "sel_record.hpp"
+
+#include <endian.h>
+
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace eSEL
+{
+
+/**
+ * @brief Check payload size of the sections with fixed data structure.
+ *
+ * @param[in] header - section header
+ *
+ * @return true if payload size is valid for the section type
+ */
+inline bool checkPayloadSize(const Section::Header& header) noexcept
+{
+    const size_t size = header.length - sizeof(Section::Header);
+    switch (header.id)
+    {
+        case SectionPH::SectionId:
+            return size == sizeof(SectionPH::PHData);
+        case SectionPS::SectionId:
+            return size == sizeof(SectionPS::PSRCData);
+        case SectionUH::SectionId:
+            return size == sizeof(SectionUH::UHData);
+    }
+    return true;
+}
+
+/**
+ * @brief Create typed section instance.
+ *
+ * @param[in] header - section header
+ * @param[in] payload - section payload
+ *
+ * @return typed section pointer
+ */
+inline std::unique_ptr<Section> createSection(const Section::Header& header,
+                                              Section::Payload&& payload)
+{
+    Section* section;
+    switch (header.id)
+    {
+        case SectionPH::SectionId:
+            section = new SectionPH(header, std::move(payload));
+            break;
+        case SectionPS::SectionId:
+            section = new SectionPS(header, std::move(payload));
+            break;
+        case SectionUH::SectionId:
+            section = new SectionUH(header, std::move(payload));
+            break;
+        case SectionUD::SectionId:
+            section = new SectionUD(header, std::move(payload));
+            break;
+        default:
+            section = new Section(header, std::move(payload));
+    }
+
+    return std::unique_ptr<Section>(section);
+}
+
+/**
+ * @brief Create section instance of the specified type in the memory
+ *        resource.
+ *
+ * @param[in] header - section header
+ * @param[in] payload - section payload
+ * @param[in] resource - memory resource for the instance
+ *
+ * @return section pointer
+ */
+template <typename T>
+std::shared_ptr<Section> allocateSection(const Section::Header& header,
+                                         Section::Payload&& payload,
+                                         std::pmr::memory_resource* resource)
+{
+    return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(resource),
+                                   header, std::move(payload));
+}
+
+/**
+ * @brief Create typed section instance in the memory resource.
+ *
+ * @param[in] header - section header
+ * @param[in] payload - section payload
+ * @param[in] resource - memory resource for the instance
+ *
+ * @return typed section pointer
+ */
+inline std::shared_ptr<Section>
+    createSection(const Section::Header& header, Section::Payload&& payload,
+                  std::pmr::memory_resource* resource)
+{
+    switch (header.id)
+    {
+        case SectionPH::SectionId:
+            return allocateSection<SectionPH>(header, std::move(payload),
+                                              resource);
+        case SectionPS::SectionId:
+            return allocateSection<SectionPS>(header, std::move(payload),
+                                              resource);
+        case SectionUH::SectionId:
+            return allocateSection<SectionUH>(header, std::move(payload),
+                                              resource);
+        case SectionUD::SectionId:
+            return allocateSection<SectionUD>(header, std::move(payload),
+                                              resource);
+    }
+    return allocateSection<Section>(header, std::move(payload), resource);
+}
+
+/**
+ * @brief Walk through sections of eSEL raw data.
+ *        The sink must provide two methods:
+ *        `void reserve(size_t count)` called once with number of sections,
+ *        `ParseError append(const SectionView& section)` called for each
+ *        section in order.
+ *
+ * @param[in] data - pointer to the data buffer
+ * @param[in] len - size of the data buffer in bytes
+ * @param[out] selRecord - SEL record if eSEL has it
+ * @param[out] length - size of eSEL in bytes
+ * @param[in] sink - receiver of sections
+ *
+ * @return parsing status
+ */
+template <typename Sink>
+ParseStatus walkEvent(const uint8_t* data, size_t len,
+                      std::optional<SelRecord>& selRecord, size_t& length,
+                      Sink& sink)
+{
+    if (!data)
+        return {ParseError::InvalidBuffer, 0};
+    if (len < sizeof(SectionPH::PHData))
+        return {ParseError::BufferTooSmall, 0};
+
+    size_t pos = 0;
+
+    // eSEL always starts with Private Header, this is the first section.
+    // But in some cases we may have SEL record at the top of raw data.
+    if (be16toh(*reinterpret_cast<const uint16_t*>(data)) !=
+        SectionPH::SectionId)
+    {
+        if (len < sizeof(SelRecord))
+            return {ParseError::BufferTooSmall, 0};
+        selRecord = SelRecord(data, len);
+        pos += sizeof(SelRecord);
+    }
+
+    // Check for starting point of the first section (Private Header)
+    if (len < pos + sizeof(SectionPH::PHData))
+        return {ParseError::BufferTooSmall, pos};
+    if (be16toh(*reinterpret_cast<const uint16_t*>(data + pos)) !=
+        SectionPH::SectionId)
+        return {ParseError::NoPrivateHeader, pos};
+
+    SectionView section;
+    ParseError rc = Section::readHeader(data + pos, len - pos, section.header);
+    if (rc != ParseError::None)
+        return {rc, pos};
+    if (!checkPayloadSize(section.header))
+        return {ParseError::PayloadSize, pos};
+
+    // Get sections count from the first section (Private Header)
+    const size_t sectionsCount = std::max<size_t>(
+        1, reinterpret_cast<const SectionPH::PHData*>(data + pos +
+                                                      sizeof(Section::Header))
+               ->sectionCount);
+    sink.reserve(sectionsCount);
+
+    for (size_t i = 0; i < sectionsCount; ++i)
+    {
+        if (i) // Private Header is already read
+        {
+            if (pos >= len)
+                return {ParseError::UnexpectedEnd, pos};
+            rc = Section::readHeader(data + pos, len - pos, section.header);
+            if (rc != ParseError::None)
+                return {rc, pos};
+        }
+        section.payload =
+            ByteSpan(data + pos + sizeof(Section::Header),
+                     section.header.length - sizeof(Section::Header));
+        rc = sink.append(section);
+        if (rc != ParseError::None)
+            return {rc, pos};
+        pos += section.header.length;
+        length = pos;
+    }
+
+    return {ParseError::None, pos};
+}
+
+} // namespace eSEL
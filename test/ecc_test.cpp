@@ -0,0 +1,81 @@
+/**
+ * @brief Unit tests for ECC of PNOR flash data.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ecc.hpp>
+
+#include <gtest/gtest.h>
+
+/**
+ * @brief Create ECC protected data.
+ *
+ * @param[in] data - source data, size must be a multiple of 8
+ *
+ * @return data with ECC
+ */
+static std::vector<uint8_t> addEcc(const std::vector<uint8_t>& data)
+{
+    std::vector<uint8_t> protectedData;
+    for (size_t i = 0; i < data.size(); i += 8)
+    {
+        protectedData.insert(protectedData.end(), &data[i], &data[i + 8]);
+        protectedData.push_back(eSEL::eccGenerate(&data[i]));
+    }
+    return protectedData;
+}
+
+TEST(EccTest, Generate)
+{
+    // The first word of HBEL partition
+    const uint8_t word[] = {0x50, 0x48, 0x00, 0x30, 0x01, 0x00, 0x09, 0x00};
+    ASSERT_EQ(0xb6, eSEL::eccGenerate(word));
+}
+
+TEST(EccTest, Remove)
+{
+    std::vector<uint8_t> data(64);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<uint8_t>(i * 37 + 11);
+    std::vector<uint8_t> ecc = addEcc(data);
+    ecc.push_back(0xaa); // incomplete word
+    data.push_back(0xaa);
+
+    ASSERT_EQ(data.size(), eSEL::eccDataSize(ecc.size()));
+    std::vector<uint8_t> out(data.size());
+    eSEL::EccStatus status =
+        eSEL::removeEcc(ecc.data(), ecc.size(), out.data());
+    ASSERT_EQ(0, status.corrected);
+    ASSERT_TRUE(status.uncorrectable.empty());
+    ASSERT_EQ(data, out);
+
+    // Single-bit errors in each bit of data and ECC
+    for (size_t bit = 0; bit < 9 * 8; ++bit)
+    {
+        std::vector<uint8_t> broken = ecc;
+        broken[9 + bit / 8] ^= 1 << (bit % 8);
+        status = eSEL::removeEcc(broken.data(), broken.size(), out.data());
+        ASSERT_EQ(1, status.corrected);
+        ASSERT_TRUE(status.uncorrectable.empty());
+        ASSERT_EQ(data, out);
+    }
+
+    // Double-bit error
+    ecc[18] ^= 0x81;
+    status = eSEL::removeEcc(ecc.data(), ecc.size(), out.data());
+    ASSERT_EQ(0, status.corrected);
+    ASSERT_EQ(std::vector<size_t>({18}), status.uncorrectable);
+}
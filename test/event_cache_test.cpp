@@ -0,0 +1,219 @@
+/**
+ * @brief Unit tests for persistent cache of printed events.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <event_cache.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+/**
+ * @class EventCacheTest
+ * @brief Test fixture: temporary cache directory.
+ */
+class EventCacheTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char path[] = "/tmp/esel_cache_test.XXXXXX";
+        ASSERT_NE(nullptr, mkdtemp(path));
+        dir = path;
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+    }
+
+    /**
+     * @brief Get cache entry files.
+     *
+     * @return paths to the entry files
+     */
+    std::vector<fs::path> entries() const
+    {
+        std::vector<fs::path> files;
+        for (const auto& it : fs::directory_iterator(dir))
+        {
+            if (it.path().extension() == ".eselcache")
+                files.push_back(it.path());
+        }
+        return files;
+    }
+
+    /**
+     * @brief Create file with specified size and age.
+     *
+     * @param[in] name - name of the file in the cache directory
+     * @param[in] size - size of the file in bytes
+     * @param[in] age - age of the file
+     */
+    void createFile(const char* name, uintmax_t size,
+                    std::chrono::hours age) const
+    {
+        const fs::path path = dir / name;
+        std::ofstream(path).close();
+        fs::resize_file(path, size); // sparse, doesn't take disk space
+        fs::last_write_time(path, fs::file_time_type::clock::now() - age);
+    }
+
+    /** @brief Path to the cache directory. */
+    fs::path dir;
+};
+
+/** @brief Raw data of test events. */
+static const std::vector<uint8_t> eventA = {0x50, 0x48, 0x00, 0x30};
+static const std::vector<uint8_t> eventB = {0x50, 0x48, 0x00, 0x31};
+
+/**
+ * @brief Get span of the event data.
+ *
+ * @param[in] data - raw event data
+ *
+ * @return data span
+ */
+static eSEL::ByteSpan span(const std::vector<uint8_t>& data)
+{
+    return eSEL::ByteSpan(data.data(), data.size());
+}
+
+TEST_F(EventCacheTest, StoreAndFind)
+{
+    const EventCache cache(dir.c_str(), "context");
+    ASSERT_FALSE(cache.find(span(eventA)).file);
+
+    cache.store(span(eventA), "Printed A", "Warning A\n");
+    cache.store(span(eventB), "Printed B", "");
+
+    const EventCache::Entry a = cache.find(span(eventA));
+    ASSERT_TRUE(a.file);
+    ASSERT_EQ("Printed A", a.output);
+    ASSERT_EQ("Warning A\n", a.diagnostics);
+
+    const EventCache::Entry b = cache.find(span(eventB));
+    ASSERT_TRUE(b.file);
+    ASSERT_EQ("Printed B", b.output);
+    ASSERT_TRUE(b.diagnostics.empty());
+}
+
+TEST_F(EventCacheTest, Replace)
+{
+    const EventCache cache(dir.c_str(), "context");
+    cache.store(span(eventA), "Old", "");
+    const EventCache::Entry old = cache.find(span(eventA));
+    cache.store(span(eventA), "New output", "");
+
+    // Mapped old entry is not affected by the replacement
+    ASSERT_EQ("Old", old.output);
+    ASSERT_EQ("New output", cache.find(span(eventA)).output);
+
+    // No temporary files are left
+    size_t files = 0;
+    for (const auto& it : fs::directory_iterator(dir))
+    {
+        ASSERT_EQ(".eselcache", it.path().extension());
+        ++files;
+    }
+    ASSERT_EQ(1, files);
+}
+
+TEST_F(EventCacheTest, KeyMismatch)
+{
+    const EventCache cache(dir.c_str(), "context");
+    cache.store(span(eventA), "Printed A", "");
+    const fs::path pathA = entries().front();
+
+    // Entry of another event under the same name (hash collision)
+    cache.store(span(eventB), "Printed B", "");
+    std::vector<fs::path> files = entries();
+    const fs::path pathB = files[0] == pathA ? files[1] : files[0];
+    fs::copy_file(pathA, pathB, fs::copy_options::overwrite_existing);
+    ASSERT_FALSE(cache.find(span(eventB)).file);
+    ASSERT_TRUE(cache.find(span(eventA)).file);
+
+    // Damaged entry
+    fs::resize_file(pathA, fs::file_size(pathA) - 1);
+    ASSERT_FALSE(cache.find(span(eventA)).file);
+}
+
+TEST_F(EventCacheTest, ContextMismatch)
+{
+    const EventCache first(dir.c_str(), "first");
+    first.store(span(eventA), "Printed A", "");
+    const fs::path pathFirst = entries().front();
+    ASSERT_FALSE(EventCache(dir.c_str(), "second").find(span(eventA)).file);
+
+    // Entry of another context under the same name (hash collision)
+    const EventCache second(dir.c_str(), "second");
+    second.store(span(eventA), "Printed A", "");
+    std::vector<fs::path> files = entries();
+    const fs::path pathSecond = files[0] == pathFirst ? files[1] : files[0];
+    fs::copy_file(pathFirst, pathSecond, fs::copy_options::overwrite_existing);
+    ASSERT_FALSE(second.find(span(eventA)).file);
+    ASSERT_TRUE(first.find(span(eventA)).file);
+}
+
+TEST_F(EventCacheTest, Touch)
+{
+    const EventCache cache(dir.c_str(), "context");
+    cache.store(span(eventA), "Printed A", "");
+    const fs::path path = entries().front();
+    const auto old = fs::file_time_type::clock::now() - std::chrono::hours(48);
+    fs::last_write_time(path, old);
+
+    ASSERT_TRUE(cache.find(span(eventA)).file);
+    ASSERT_LT(old + std::chrono::hours(1), fs::last_write_time(path));
+}
+
+TEST_F(EventCacheTest, PruneByAge)
+{
+    createFile("expired.eselcache", 16, std::chrono::hours(24 * 31));
+    createFile("fresh.eselcache", 16, std::chrono::hours(24 * 29));
+    createFile("expired.eselcache.AbCdEf", 16, std::chrono::hours(24 * 31));
+    createFile("unrelated", 16, std::chrono::hours(24 * 31));
+
+    const EventCache cache(dir.c_str(), "context");
+    ASSERT_FALSE(fs::exists(dir / "expired.eselcache"));
+    ASSERT_TRUE(fs::exists(dir / "fresh.eselcache"));
+    ASSERT_FALSE(fs::exists(dir / "expired.eselcache.AbCdEf"));
+    ASSERT_TRUE(fs::exists(dir / "unrelated"));
+}
+
+TEST_F(EventCacheTest, PruneBySize)
+{
+    const uintmax_t mib = 1024 * 1024;
+    createFile("oldest.eselcache", 30 * mib, std::chrono::hours(3));
+    createFile("older.eselcache", 30 * mib, std::chrono::hours(2));
+    createFile("newest.eselcache", 30 * mib, std::chrono::hours(1));
+
+    // Least recently used entries are removed until the limit is reached
+    const EventCache cache(dir.c_str(), "context");
+    ASSERT_FALSE(fs::exists(dir / "oldest.eselcache"));
+    ASSERT_TRUE(fs::exists(dir / "older.eselcache"));
+    ASSERT_TRUE(fs::exists(dir / "newest.eselcache"));
+}
@@ -0,0 +1,89 @@
+/**
+ * @brief Unit tests for hex text decoder.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fmtexcept.hpp>
+#include <hex_text.hpp>
+#include <string>
+
+#include <gtest/gtest.h>
+
+/**
+ * @brief Decode hex text.
+ *
+ * @param[in] text - source text
+ *
+ * @return decoded data
+ */
+static std::vector<uint8_t> decode(const std::string& text)
+{
+    std::vector<uint8_t> out;
+    eSEL::decodeHexText(text.data(), text.size(), out);
+    return out;
+}
+
+TEST(HexTextTest, Simple)
+{
+    ASSERT_EQ(std::vector<uint8_t>(), decode(""));
+    ASSERT_EQ(std::vector<uint8_t>({0x50, 0x48, 0xab, 0xcd}),
+              decode(" 50 48\n\tAb cD "));
+    ASSERT_EQ(std::vector<uint8_t>({0x50, 0x48}), decode("5048\"0030"));
+    ASSERT_THROW(decode("50 4 8"), eSEL::InvalidFormat);
+    ASSERT_THROW(decode("504"), eSEL::InvalidFormat);
+}
+
+TEST(HexTextTest, Stream)
+{
+    std::vector<uint8_t> out;
+    ASSERT_EQ(5, eSEL::decodeHexText("50 48", 5, out, false));
+    ASSERT_EQ(3, eSEL::decodeHexText(" ab0", 4, out, false));
+    // Incomplete byte is passed again with the next block
+    ASSERT_EQ(5, eSEL::decodeHexText("00 cd\"", 6, out, false));
+    ASSERT_EQ(std::vector<uint8_t>({0x50, 0x48, 0xab, 0x00, 0xcd}), out);
+    ASSERT_THROW(eSEL::decodeHexText("1 2", 3, out, false),
+                 eSEL::InvalidFormat);
+}
+
+TEST(HexTextTest, Formats)
+{
+    std::vector<uint8_t> data;
+    for (size_t i = 0; i < 300; ++i)
+        data.push_back(static_cast<uint8_t>(i * 7));
+
+    static const char digits[] = "0123456789abcdef";
+    std::string dense, spaced, lines;
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        const char hex[] = {digits[data[i] >> 4], digits[data[i] & 0x0f]};
+        dense.append(hex, 2);
+        spaced.append(hex, 2);
+        spaced += ' ';
+        lines.append(hex, 2);
+        lines += i % 16 == 15 ? '\n' : ' ';
+    }
+
+    ASSERT_EQ(data, decode(dense));
+    ASSERT_EQ(data, decode(spaced));
+    ASSERT_EQ(data, decode(lines));
+
+    // invalid character inside SIMD block
+    spaced[102] = 'x';
+    std::vector<uint8_t> out;
+    ASSERT_EQ(102, eSEL::decodeHexText(spaced.data(), spaced.size(), out));
+    ASSERT_EQ(34, out.size());
+    ASSERT_THROW(decode(spaced.substr(0, 102) + "0x"), eSEL::InvalidFormat);
+}
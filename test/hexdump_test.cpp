@@ -0,0 +1,64 @@
+/**
+ * @brief Unit tests for hex dump.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hexdump.hpp>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(HexDumpTest, Empty)
+{
+    ASSERT_EQ(0, eSEL::hexDumpSize(0));
+    ASSERT_EQ("", eSEL::hexDump(nullptr, 0));
+}
+
+TEST(HexDumpTest, Format)
+{
+    std::vector<uint8_t> data;
+    for (size_t i = 0; i < 20; ++i)
+        data.push_back(static_cast<uint8_t>(0x7a + i));
+
+    // hex view is padded to 52 characters
+    const std::string row1 =
+        "7a 7b 7c 7d  7e 7f 80 81  82 83 84 85  86 87 88 89  ";
+    const std::string row2 = "8a 8b 8c 8d" + std::string(41, ' ');
+
+    ASSERT_EQ("0000:   " + row1 + " z{|}~...........\n" + "0010:   " + row2 +
+                  " ....",
+              eSEL::hexDump(data.data(), data.size()));
+    ASSERT_EQ(row1 + "\n" + row2,
+              eSEL::hexDump(data.data(), data.size(), false, false));
+}
+
+TEST(HexDumpTest, Size)
+{
+    std::vector<uint8_t> data(100, 'a');
+    for (size_t len = 0; len < data.size(); ++len)
+    {
+        for (int flags = 0; flags < 4; ++flags)
+        {
+            const bool offset = flags & 1;
+            const bool ascii = flags & 2;
+            std::string out = "prefix";
+            eSEL::appendHexDump(out, data.data(), len, offset, ascii);
+            ASSERT_EQ(6 + eSEL::hexDumpSize(len, offset, ascii), out.size());
+            ASSERT_EQ(eSEL::hexDump(data.data(), len, offset, ascii),
+                      out.substr(6));
+        }
+    }
+}
@@ -16,11 +16,21 @@
  * limitations under the License.
  */
 
+#include <compact_event.hpp>
 #include <event.hpp>
+#include <event_batch.hpp>
+#include <event_parser.hpp>
+#include <event_view.hpp>
+#include <ltables.hpp>
 #include <section_ph.hpp>
 #include <section_ps.hpp>
 #include <section_ud.hpp>
 #include <section_uh.hpp>
+#include <summary.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -386,3 +396,407 @@ TEST(ParserTest, Parse)
 
     ASSERT_EQ(7, event.getSections().size());
 }
+
+TEST(ParserTest, ParseView)
+{
+    const std::vector<uint8_t> sel = makeSEL({
+        phData,
+        uhData,
+        psData,
+        udStrData,
+    });
+    eSEL::EventView view;
+    view.parse(sel.data(), sel.size());
+
+    const eSEL::SectionViews& sections = view.getSections();
+    ASSERT_EQ(4, sections.size());
+    ASSERT_FALSE(view.getSelRecord());
+
+    // Payloads must refer to the source buffer
+    size_t pos = 0;
+    for (const auto& section : sections)
+    {
+        ASSERT_EQ(sel.data() + pos + sizeof(eSEL::Section::Header),
+                  section.payload.data());
+        ASSERT_EQ(section.header.length,
+                  section.payload.size() + sizeof(eSEL::Section::Header));
+        pos += section.header.length;
+    }
+    ASSERT_EQ(eSEL::SectionPH::SectionId, sections[0].header.id);
+    ASSERT_EQ(eSEL::SectionUH::SectionId, sections[1].header.id);
+    ASSERT_EQ(eSEL::SectionPS::SectionId, sections[2].header.id);
+    ASSERT_EQ(eSEL::SectionUD::SectionId, sections[3].header.id);
+    ASSERT_EQ(0x0100, sections[3].header.component);
+}
+
+TEST(ParserTest, LazyDecoding)
+{
+    /** @brief Section that counts payload decoding. */
+    class CountingSection : public eSEL::Section
+    {
+      public:
+        using eSEL::Section::Section;
+        mutable std::atomic<size_t> decodeCount{0};
+
+      protected:
+        void decodePayload(eSEL::Params& params,
+                           eSEL::Diagnostics& diagnostics) const override
+        {
+            ++decodeCount;
+            params.emplace_back(eSEL::Param{"Payload size", payload_.size()});
+            diagnostics.warnings.push_back("Decoded");
+        }
+    };
+
+    const eSEL::Section::Header hdr{0x4142, 16, 1, 0, 0};
+    CountingSection section(hdr, eSEL::Section::Payload(8, 0xaa));
+    ASSERT_EQ(0, section.decodeCount);
+    ASSERT_EQ(8, section.payload().size());
+    ASSERT_TRUE(section.diagnostics().warnings.empty());
+    ASSERT_EQ(0, section.decodeCount);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i)
+        threads.emplace_back([&section]() { section.payloadParams(); });
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(1, section.decodeCount);
+    ASSERT_EQ(1, section.payloadParams().size());
+    ASSERT_EQ(1, section.decodeCount);
+    ASSERT_TRUE(section.diagnostics().errors.empty());
+    ASSERT_EQ(1, section.diagnostics().warnings.size());
+    ASSERT_EQ(1, section.decodeCount);
+}
+
+TEST(ParserTest, Summary)
+{
+    const std::vector<uint8_t> sel = makeSEL({
+        phData,
+        uhData,
+        psData,
+        udStrData,
+    });
+    const eSEL::EventSummary summary = eSEL::summarize(sel.data(), sel.size());
+
+    ASSERT_TRUE(summary.valid);
+    ASSERT_EQ(0x90000047, summary.logEntryId);
+    ASSERT_EQ(0x90000047, summary.platformId);
+    ASSERT_EQ(0x0000000a4d71e974, summary.createTimestamp);
+    ASSERT_EQ(0x0000000a4f680d96, summary.commitTimestamp);
+    ASSERT_EQ('B', summary.creator);
+    ASSERT_EQ(4, summary.sectionCount);
+
+    ASSERT_TRUE(summary.hasUserHeader);
+    ASSERT_EQ(0x20, summary.subsystem);
+    ASSERT_EQ(0x40, summary.severity);
+    ASSERT_EQ(0x00, summary.eventType);
+    ASSERT_EQ(0x03, summary.scope);
+    ASSERT_EQ(0x0000, summary.action);
+
+    ASSERT_TRUE(summary.hasPrimarySrc);
+    ASSERT_STREQ("BC8A090F", summary.primaryRefCode);
+    ASSERT_EQ(0x000000e0, summary.extRefCode[0]);
+    ASSERT_EQ(0x0038aedf, summary.extRefCode[5]);
+}
+
+TEST(ParserTest, SummaryCorrupted)
+{
+    const std::vector<uint8_t> sel = makeSEL({phData, uhData});
+    ASSERT_FALSE(eSEL::summarize(nullptr, 0).valid);
+    ASSERT_FALSE(eSEL::summarize(sel.data(), 10).valid);
+
+    // Truncated User Header
+    const eSEL::EventSummary summary =
+        eSEL::summarize(sel.data(), sel.size() - 1);
+    ASSERT_TRUE(summary.valid);
+    ASSERT_FALSE(summary.hasUserHeader);
+    ASSERT_FALSE(summary.hasPrimarySrc);
+}
+
+TEST(ParserTest, ReadHeaderOffset)
+{
+    try
+    {
+        eSEL::Section::readHeader(phData.data(), 4, 0x30);
+        FAIL() << "InvalidFormat expected";
+    }
+    catch (const eSEL::InvalidFormat& ex)
+    {
+        ASSERT_NE(nullptr, std::strstr(ex.what(), "at offset 48"));
+    }
+}
+
+TEST(ParserTest, ParseCompact)
+{
+    const std::vector<uint8_t> sel = makeSEL({
+        phData,
+        uhData,
+        psData,
+        udStrData,
+        udTrgData,
+    });
+    eSEL::CompactEvent event;
+    event.parse(sel.data(), sel.size());
+
+    const eSEL::SectionValues& sections = event.getSections();
+    ASSERT_EQ(5, sections.size());
+    ASSERT_TRUE(std::holds_alternative<eSEL::SectionPH>(sections[0]));
+    ASSERT_TRUE(std::holds_alternative<eSEL::SectionUD>(sections[4]));
+    ASSERT_EQ("User Header", eSEL::asSection(sections[1]).name());
+
+    const eSEL::SectionPS* ps = event.find<eSEL::SectionPS>();
+    ASSERT_NE(nullptr, ps);
+    ASSERT_EQ(0x09, ps->data().wordCount);
+    ASSERT_EQ(&std::get<eSEL::SectionUD>(sections[3]),
+              event.find<eSEL::SectionUD>());
+    ASSERT_EQ(nullptr, event.find<eSEL::Section>());
+    assertEqual(event.find<eSEL::SectionUH>()->payloadParams(), uhPayload);
+
+    const std::vector<const eSEL::SectionUD*> ud =
+        event.findAll<eSEL::SectionUD>();
+    ASSERT_EQ(2, ud.size());
+    ASSERT_EQ(&std::get<eSEL::SectionUD>(sections[3]), ud[0]);
+    ASSERT_EQ(&std::get<eSEL::SectionUD>(sections[4]), ud[1]);
+    ASSERT_TRUE(event.findAll<eSEL::Section>().empty());
+}
+
+TEST(ParserTest, TryParse)
+{
+    const std::vector<uint8_t> sel = makeSEL({phData, uhData, psData});
+
+    eSEL::Event event;
+    eSEL::ParseStatus status = event.tryParse(sel.data(), sel.size());
+    ASSERT_TRUE(status);
+    ASSERT_EQ(3, event.getSections().size());
+
+    // cut off the last section
+    const size_t cut = sel.size() - 16;
+    eSEL::Event partial;
+    status = partial.tryParse(sel.data(), cut);
+    ASSERT_FALSE(status);
+    ASSERT_EQ(eSEL::ParseError::SectionOverflow, status.error);
+    ASSERT_EQ(sel.size() - psData.size(), status.offset);
+    ASSERT_EQ(2, partial.getSections().size());
+    ASSERT_THROW(eSEL::Event().parse(sel.data(), cut), eSEL::InvalidFormat);
+
+    eSEL::EventView view;
+    status = view.tryParse(sel.data() + 1, sel.size() - 1);
+    ASSERT_EQ(eSEL::ParseError::NoPrivateHeader, status.error);
+    ASSERT_TRUE(view.getSections().empty());
+}
+
+TEST(ParserTest, ParseChunked)
+{
+    const std::vector<uint8_t> sel = makeSEL({phData, uhData, psData});
+
+    for (size_t chunk : {1, 3, 64, 1024})
+    {
+        std::vector<std::unique_ptr<eSEL::Section>> sections;
+        eSEL::EventParser parser([&](std::unique_ptr<eSEL::Section> section) {
+            sections.emplace_back(std::move(section));
+        });
+
+        for (size_t pos = 0; pos < sel.size(); pos += chunk)
+        {
+            const size_t size = std::min(chunk, sel.size() - pos);
+            ASSERT_TRUE(parser.feed(sel.data() + pos, size));
+            // section must be emitted as soon as its last byte arrived
+            if (pos + size >= phData.size())
+                ASSERT_FALSE(sections.empty());
+            else
+                ASSERT_TRUE(sections.empty());
+        }
+
+        ASSERT_TRUE(parser.complete());
+        ASSERT_EQ(sel.size(), parser.length());
+        ASSERT_EQ(3, sections.size());
+        ASSERT_EQ(eSEL::SectionPS::SectionId, sections[2]->header().id);
+        assertEqual(sections[1]->payloadParams(), uhPayload);
+    }
+
+    // broken stream
+    size_t count = 0;
+    eSEL::EventParser parser(
+        [&](std::unique_ptr<eSEL::Section>) { ++count; });
+    ASSERT_TRUE(parser.feed(sel.data(), sel.size() - 1));
+    ASSERT_FALSE(parser.complete());
+    ASSERT_EQ(2, count);
+
+    parser.reset();
+    const eSEL::ParseStatus status = parser.feed(uhData.data(), uhData.size());
+    ASSERT_EQ(eSEL::ParseError::NoPrivateHeader, status.error);
+    ASSERT_FALSE(parser.feed(sel.data(), sel.size()));
+}
+
+TEST(ParserTest, ParallelDecode)
+{
+    eSEL::ThreadPool pool(4);
+    ASSERT_EQ(4, pool.size());
+
+    std::vector<std::future<size_t>> results;
+    for (size_t i = 0; i < 100; ++i)
+        results.emplace_back(pool.submit([i]() { return i * i; }));
+    for (size_t i = 0; i < results.size(); ++i)
+        ASSERT_EQ(i * i, results[i].get());
+    ASSERT_THROW(pool.submit([]() { throw std::runtime_error("err"); }).get(),
+                 std::runtime_error);
+
+    const std::vector<uint8_t> sel = makeSEL({phData, uhData, uhData});
+    eSEL::Event event;
+    event.parse(sel.data(), sel.size());
+    event.decode(pool);
+
+    const eSEL::Sections& sections = event.getSections();
+    ASSERT_EQ(3, sections.size());
+    assertEqual(sections[1]->payloadParams(), uhPayload);
+    assertEqual(sections[2]->payloadParams(), uhPayload);
+}
+
+TEST(ParserTest, Batch)
+{
+    const std::vector<uint8_t> sel1 = makeSEL({phData, uhData, psData});
+    const std::vector<uint8_t> sel2 = makeSEL({phData, udStrData});
+
+    // Contiguous image: two events and garbage
+    std::vector<uint8_t> image(sel1);
+    image.insert(image.end(), sel2.begin(), sel2.end());
+    image.insert(image.end(), 16, 0xff);
+
+    // Slot based image: two events and empty slot
+    const size_t slotSize = 512;
+    std::vector<uint8_t> slots(slotSize * 3, 0xff);
+    std::copy(sel1.begin(), sel1.end(), slots.begin());
+    std::copy(sel2.begin(), sel2.end(), slots.begin() + slotSize);
+
+    eSEL::EventBatch batch;
+
+    // Default resource must not be used while parsing
+    std::pmr::memory_resource* defaultResource =
+        std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    batch.parse({eSEL::ByteSpan(sel1.data(), sel1.size()),
+                 eSEL::ByteSpan(sel2.data(), sel2.size())});
+    batch.parse(slots.data(), slots.size(), slotSize);
+    std::pmr::set_default_resource(defaultResource);
+
+    batch.parse(image.data(), image.size());
+
+    const eSEL::EventBatch::Entries& events = batch.getEvents();
+    ASSERT_EQ(7, events.size());
+    for (size_t i = 0; i < 6; ++i)
+    {
+        ASSERT_TRUE(events[i].status);
+        ASSERT_EQ(i % 2 ? 2 : 3, events[i].event.getSections().size());
+    }
+    ASSERT_EQ(sel1.size(), events[4].event.length());
+    ASSERT_EQ(image.data() + sel1.size(), events[5].data.data());
+    ASSERT_FALSE(events[6].status);
+
+    // Decoded parameters share the memory of the batch
+    const eSEL::Sections& sections = events[0].event.getSections();
+    std::pmr::memory_resource* arena = sections.get_allocator().resource();
+    const eSEL::Params& params = sections[1]->payloadParams();
+    assertEqual(params, uhPayload);
+    ASSERT_EQ(arena, params.get_allocator().resource());
+    ASSERT_EQ(eSEL::Param::String, params[0].type());
+    ASSERT_EQ(arena, std::get<std::pmr::string>(params[0].variant())
+                         .get_allocator()
+                         .resource());
+
+    batch.clear();
+    ASSERT_TRUE(batch.getEvents().empty());
+}
+
+TEST(ParserTest, ParamFormat)
+{
+    const eSEL::Param num("Number", static_cast<uint16_t>(0x1234));
+    const eSEL::Param str("String", "Text value");
+
+    std::string out = "Value: ";
+    num.appendValue(out);
+    ASSERT_EQ("Value: 0x1234", out);
+
+    char buf[8];
+    ASSERT_EQ(10, str.formatTo(buf, sizeof(buf)));
+    ASSERT_EQ("Text val", std::string(buf, sizeof(buf)));
+    ASSERT_EQ(5, eSEL::Param("Flag", false).formatTo(buf, sizeof(buf)));
+    ASSERT_EQ("False", std::string(buf, 5));
+    ASSERT_EQ(0, eSEL::Param().formatTo(buf, sizeof(buf)));
+}
+
+TEST(ParserTest, ParamName)
+{
+    static const char literal[] = "Static name";
+    const eSEL::Param first(literal, true);
+    ASSERT_EQ("Static name", first.name());
+    ASSERT_EQ(literal, first.name().data()); // not copied
+
+    eSEL::NameStorageRef storage;
+    std::string name = "Dynamic name";
+    const eSEL::Param second(eSEL::ParamName(name, storage),
+                             static_cast<uint8_t>(1));
+    name.assign("Changed");
+    ASSERT_EQ("Dynamic name", second.name());
+    ASSERT_TRUE(storage);
+
+    const eSEL::Param copy = second;
+    ASSERT_EQ("Dynamic name", copy.name());
+    ASSERT_TRUE(eSEL::Param().name().empty());
+
+    // Name is a reference, not an owned string
+    ASSERT_LT(sizeof(eSEL::Param), sizeof(eSEL::Param::Type) +
+                                       sizeof(std::string) +
+                                       sizeof(eSEL::Param::variant_t));
+}
+
+TEST(ParserTest, NamePool)
+{
+    eSEL::NameStorageRef storage;
+    const std::string_view first = eSEL::internName("Pooled name", storage);
+    ASSERT_EQ("Pooled name", first);
+
+    // Equal names from all threads refer to the same interned name
+    std::vector<std::string_view> interned(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < interned.size(); ++i)
+    {
+        threads.emplace_back([&interned, &storage, i]() {
+            eSEL::NameStorageRef ref = storage;
+            const std::string name = "Pooled name";
+            interned[i] = eSEL::internName(name, ref);
+            interned[i] = eSEL::internName(name, ref); // cached
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    for (const auto& it : interned)
+        ASSERT_EQ(first.data(), it.data());
+
+    // Storage is shared by empty references
+    eSEL::NameStorageRef other;
+    ASSERT_EQ(first.data(), eSEL::internName("Pooled name", other).data());
+    ASSERT_EQ(storage, other);
+
+    // Full storage is replaced for new references, old names are kept
+    const std::string longName(64 * 1024, 'x');
+    for (size_t i = 0; i < 32; ++i)
+        eSEL::internName(longName + std::to_string(i), storage);
+    eSEL::NameStorageRef next;
+    const std::string_view moved = eSEL::internName("Pooled name", next);
+    ASSERT_NE(storage, next);
+    ASSERT_NE(first.data(), moved.data());
+    ASSERT_EQ("Pooled name", first);
+}
+
+TEST(ParserTest, LookupTable)
+{
+    static constexpr eSEL::LookupTable<uint8_t> table = {
+        {0x01, "First"}, {0x02, "Second"}, {0x01, "Duplicate"}};
+    static_assert(table.find(0x01) == "First");
+
+    ASSERT_EQ("Second", table.get(0x02));
+    ASSERT_EQ("Unknown (0x03)", table.get(0x03));
+    ASSERT_EQ("", table.get(0x03, nullptr));
+    ASSERT_TRUE(table.find(0xff).empty());
+    ASSERT_EQ("Hostboot", eSEL::SubsystemName.get(0x8a));
+}
@@ -0,0 +1,98 @@
+/**
+ * @brief Unit tests for eSEL printer.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <printer.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+/**
+ * @brief Print range of empty events.
+ *
+ * @param[in] printer - printer instance
+ * @param[in] titles - titles of events
+ *
+ * @return printed output
+ */
+static std::string printRange(const Printer& printer,
+                              const std::vector<std::string>& titles)
+{
+    const eSEL::Event event;
+    std::ostringstream os;
+    printer.printRangeBegin(os);
+    for (size_t i = 0; i < titles.size(); ++i)
+    {
+        printer.printEntryBegin(titles[i], i == 0, os);
+        printer.print(event, os);
+        printer.printEntryEnd(os);
+    }
+    printer.printRangeEnd(os);
+    return os.str();
+}
+
+TEST(PrinterTest, RangeJson)
+{
+    Printer printer;
+    printer.setFormat(Printer::Json);
+
+    ASSERT_EQ("[\n\n]\n", printRange(printer, {}));
+    ASSERT_EQ("[\n"
+              "{\n"
+              "\"title\": \"BMC event 1\",\n"
+              "\"event\": {\n"
+              "  \"sections\": [\n"
+              "  ]\n"
+              "}\n"
+              "},\n"
+              "{\n"
+              "\"title\": \"BMC \\\"2\\\"\",\n"
+              "\"event\": {\n"
+              "  \"sections\": [\n"
+              "  ]\n"
+              "}\n"
+              "}\n"
+              "]\n",
+              printRange(printer, {"BMC event 1", "BMC \"2\""}));
+}
+
+TEST(PrinterTest, Decodes)
+{
+    Printer printer;
+    ASSERT_TRUE(printer.decodes(0));
+    printer.addFilter(2);
+    ASSERT_FALSE(printer.decodes(0));
+    ASSERT_TRUE(printer.decodes(1));
+    printer.setFormat(Printer::Json);
+    ASSERT_TRUE(printer.decodes(0));
+    printer.setFormat(Printer::Hex);
+    ASSERT_FALSE(printer.decodes(1));
+    printer.setFormat(Printer::Bin);
+    ASSERT_FALSE(printer.decodes(1));
+}
+
+TEST(PrinterTest, RangeText)
+{
+    Printer printer;
+    printer.setFormat(Printer::Hex);
+
+    const std::string output = printRange(printer, {"PNOR event 0", "X"});
+    ASSERT_EQ(0, output.find("PNOR event 0:\n"));
+    ASSERT_NE(std::string::npos, output.find("\nX:\n"));
+}
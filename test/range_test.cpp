@@ -0,0 +1,86 @@
+/**
+ * @brief Unit tests for range of event IDs.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <range.hpp>
+#include <string>
+
+#include <gtest/gtest.h>
+
+TEST(RangeTest, Number)
+{
+    size_t value;
+    ASSERT_TRUE(parseNumber("0", value));
+    ASSERT_EQ(0, value);
+    ASSERT_TRUE(parseNumber("16", value));
+    ASSERT_EQ(16, value);
+    ASSERT_FALSE(parseNumber("", value));
+    ASSERT_FALSE(parseNumber("-1", value));
+    ASSERT_FALSE(parseNumber("+1", value));
+    ASSERT_FALSE(parseNumber(" 1", value));
+    ASSERT_FALSE(parseNumber("1x", value));
+    ASSERT_FALSE(parseNumber("99999999999999999999999", value));
+}
+
+TEST(RangeTest, Valid)
+{
+    size_t first, last;
+    ASSERT_TRUE(parseRange("42", first, last));
+    ASSERT_EQ(42, first);
+    ASSERT_EQ(42, last);
+    ASSERT_TRUE(parseRange("3-15", first, last));
+    ASSERT_EQ(3, first);
+    ASSERT_EQ(15, last);
+    ASSERT_TRUE(parseRange("7-7", first, last));
+    ASSERT_EQ(7, first);
+    ASSERT_EQ(7, last);
+    ASSERT_TRUE(parseRange("all", first, last));
+    ASSERT_EQ(0, first);
+    ASSERT_EQ(std::string::npos - 1, last);
+}
+
+TEST(RangeTest, Malformed)
+{
+    size_t first, last;
+    ASSERT_FALSE(parseRange("", first, last));
+    ASSERT_FALSE(parseRange("abc", first, last));
+    ASSERT_FALSE(parseRange("1a", first, last));
+    ASSERT_FALSE(parseRange("1-", first, last));
+    ASSERT_FALSE(parseRange("-1", first, last));
+    ASSERT_FALSE(parseRange("1--2", first, last));
+    ASSERT_FALSE(parseRange("1-2-3", first, last));
+    ASSERT_FALSE(parseRange(" 1", first, last));
+    ASSERT_FALSE(parseRange("+1", first, last));
+    ASSERT_FALSE(parseRange("ALL", first, last));
+}
+
+TEST(RangeTest, Reversed)
+{
+    size_t first, last;
+    ASSERT_FALSE(parseRange("5-3", first, last));
+    ASSERT_FALSE(parseRange("1-0", first, last));
+}
+
+TEST(RangeTest, OutOfRange)
+{
+    size_t first, last;
+    const std::string max = std::to_string(std::string::npos);
+    ASSERT_FALSE(parseRange(max.c_str(), first, last));
+    ASSERT_FALSE(parseRange(("0-" + max).c_str(), first, last));
+    ASSERT_FALSE(parseRange("99999999999999999999999", first, last));
+    ASSERT_FALSE(parseRange("1-99999999999999999999999", first, last));
+}
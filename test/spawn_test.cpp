@@ -0,0 +1,61 @@
+/**
+ * @brief Unit tests for execution of external utilities.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <spawn.hpp>
+#include <string>
+#include <system_error>
+
+#include <gtest/gtest.h>
+
+TEST(SpawnTest, Output)
+{
+    const uint8_t data[] = {'d', 'a', 't', 'a', '\n'};
+    eSEL::MemFile input("test");
+    input.write(data, sizeof(data));
+
+    std::string out;
+    EXPECT_EQ(0, eSEL::spawnUtility("sh",
+                                    {"-c", "echo out; echo err >&2; cat $0",
+                                     eSEL::SpawnInputPath},
+                                    &input, out));
+    EXPECT_EQ("out\nerr\ndata\n", out);
+}
+
+TEST(SpawnTest, LargeOutput)
+{
+    std::string out;
+    EXPECT_EQ(0, eSEL::spawnUtility("head", {"-c", "1000000", "/dev/zero"},
+                                    nullptr, out));
+    EXPECT_EQ(std::string(1000000, '\0'), out);
+}
+
+TEST(SpawnTest, ExitCode)
+{
+    std::string out;
+    EXPECT_EQ(3, eSEL::spawnUtility("sh", {"-c", "exit 3"}, nullptr, out));
+    EXPECT_TRUE(out.empty());
+    EXPECT_THROW(eSEL::spawnUtility("/nonexistent", {}, nullptr, out),
+                 std::system_error);
+}
+
+TEST(SpawnTest, Resolve)
+{
+    EXPECT_EQ("/bin/sh", eSEL::resolveUtility("/bin/sh"));
+    EXPECT_EQ('/', eSEL::resolveUtility("sh").front());
+    EXPECT_EQ("nonexistent_tool", eSEL::resolveUtility("nonexistent_tool"));
+}
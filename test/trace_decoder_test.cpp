@@ -0,0 +1,224 @@
+/**
+ * @brief Unit tests for trace decoder.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+#include <trace_decoder.hpp>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+/**
+ * @class TraceBuffer
+ * @brief Builder of big endian trace buffer.
+ */
+class TraceBuffer
+{
+  public:
+    TraceBuffer(const char* comp)
+    {
+        data_ = {1, 40, 0 /* real time */, 'B'};
+        data_.resize(40);
+        strncpy(reinterpret_cast<char*>(&data_[4]), comp, 16);
+    }
+
+    void add(uint32_t sec, uint16_t tag, uint32_t hash,
+             const std::vector<uint8_t>& args)
+    {
+        const size_t start = data_.size();
+        put(sec);
+        put(0);   // usec
+        put(42);  // tid
+        put(static_cast<uint32_t>(args.size() << 16 | tag));
+        put(hash);
+        put(100); // line
+        data_.insert(data_.end(), args.begin(), args.end());
+        data_.resize((data_.size() + 3) & ~3);
+        put(static_cast<uint32_t>(data_.size() - start));
+    }
+
+    void skip(size_t len)
+    {
+        data_.resize(data_.size() + len, 0xff);
+    }
+
+    size_t size() const
+    {
+        return data_.size();
+    }
+
+    std::vector<uint8_t> get(size_t nextFree = 0, uint32_t wraps = 0)
+    {
+        std::vector<uint8_t> buf = data_;
+        set(buf, 20, static_cast<uint32_t>(buf.size())); // size
+        set(buf, 24, wraps);
+        set(buf, 28, static_cast<uint32_t>(nextFree ? nextFree : buf.size()));
+        return buf;
+    }
+
+  private:
+    void put(uint32_t val)
+    {
+        data_.resize(data_.size() + sizeof(val));
+        set(data_, data_.size() - sizeof(val), val);
+    }
+
+    static void set(std::vector<uint8_t>& buf, size_t pos, uint32_t val)
+    {
+        for (size_t i = 0; i < sizeof(val); ++i)
+            buf[pos + i] = static_cast<uint8_t>(val >> ((3 - i) * 8));
+    }
+
+    std::vector<uint8_t> data_;
+};
+
+/**
+ * @brief Create string file.
+ *
+ * @return path to the file
+ */
+static std::string createStringFile()
+{
+    char path[] = "/tmp/trace_strings_XXXXXX";
+    const int fd = mkstemp(path);
+    const char content[] = "#FSP_TRACE_v2|||Today|||BUILD:/tmp\n"
+                           "1||Value %d of %s: %04llx||test.C\n"
+                           "2||Binary data||dump.C\n"
+                           "3||Unsupported %f||float.C\n";
+    EXPECT_EQ(static_cast<ssize_t>(sizeof(content) - 1),
+              write(fd, content, sizeof(content) - 1));
+    close(fd);
+    return path;
+}
+
+TEST(TraceDecoderTest, Decode)
+{
+    const std::string path = createStringFile();
+    const eSEL::TraceStrings strings(path.c_str());
+    remove(path.c_str());
+
+    TraceBuffer first("FIRST");
+    first.add(2, 0x4654, 1,
+              {0xff, 0xff, 0xff, 0xfe, 'a', 'b', 0, 0, 0, 0, 0, 0, 0, 0, 0xa,
+               0xbc});
+    TraceBuffer second("SECOND");
+    second.add(1, 0x4644, 2, {'d', 'u', 'm', 'p', 0xff});
+    std::vector<uint8_t> data = first.get();
+    const std::vector<uint8_t> data2 = second.get();
+    data.insert(data.end(), data2.begin(), data2.end());
+
+    std::string out;
+    ASSERT_TRUE(eSEL::decodeTrace(data.data(), data.size(), strings, out));
+    const size_t dump = out.find("       1.000000|   42|SECOND          |"
+                                 "dump.C(100)|Binary data\n"
+                                 "   ~[0x0000] 64756d70 ff");
+    const size_t trace = out.find("       2.000000|   42|FIRST           |"
+                                  "test.C(100)|Value -2 of ab: 0abc\n");
+    EXPECT_NE(std::string::npos, dump);
+    EXPECT_NE(std::string::npos, trace);
+    EXPECT_LT(dump, trace);
+}
+
+TEST(TraceDecoderTest, Fallback)
+{
+    const std::string path = createStringFile();
+    const eSEL::TraceStrings strings(path.c_str());
+    remove(path.c_str());
+
+    // Unknown hash
+    TraceBuffer unknown("TEST");
+    unknown.add(1, 0x4654, 4, {});
+    std::vector<uint8_t> data = unknown.get();
+    std::string out;
+    EXPECT_FALSE(eSEL::decodeTrace(data.data(), data.size(), strings, out));
+
+    // Unsupported format
+    TraceBuffer unsupported("TEST");
+    unsupported.add(1, 0x4654, 3, {0, 0, 0, 0});
+    data = unsupported.get();
+    EXPECT_FALSE(eSEL::decodeTrace(data.data(), data.size(), strings, out));
+
+    // Arguments don't match format
+    TraceBuffer mismatch("TEST");
+    mismatch.add(1, 0x4654, 1, {0, 0, 0, 1});
+    data = mismatch.get();
+    EXPECT_FALSE(eSEL::decodeTrace(data.data(), data.size(), strings, out));
+
+    // Truncated buffer
+    data.resize(data.size() - 1);
+    EXPECT_FALSE(eSEL::decodeTrace(data.data(), data.size(), strings, out));
+
+    EXPECT_THROW(eSEL::TraceStrings("/nonexistent"), std::system_error);
+}
+
+TEST(TraceDecoderTest, Wrapped)
+{
+    const std::string path = createStringFile();
+    const eSEL::TraceStrings strings(path.c_str());
+    remove(path.c_str());
+
+    // Latest entry is written after the header, older entries are at the
+    // end of the buffer after the rest of overwritten entry
+    TraceBuffer wrapped("WRAP");
+    wrapped.add(3, 0x4644, 2, {3});
+    const size_t nextFree = wrapped.size();
+    wrapped.skip(8);
+    wrapped.add(1, 0x4644, 2, {1});
+    wrapped.add(2, 0x4644, 2, {2});
+    std::vector<uint8_t> data = wrapped.get(nextFree, 1);
+
+    std::string out;
+    ASSERT_TRUE(eSEL::decodeTrace(data.data(), data.size(), strings, out));
+    const size_t first = out.find("       1.000000|");
+    const size_t second = out.find("       2.000000|");
+    const size_t third = out.find("       3.000000|");
+    EXPECT_NE(std::string::npos, first);
+    EXPECT_LT(first, second);
+    EXPECT_LT(second, third);
+
+    // Unknown layout of the older part
+    wrapped.skip(8);
+    data = wrapped.get(nextFree, 1);
+    EXPECT_FALSE(eSEL::decodeTrace(data.data(), data.size(), strings, out));
+}
+
+TEST(TraceDecoderTest, Rename)
+{
+    std::vector<uint8_t> data = TraceBuffer("FIRST").get();
+    const std::vector<uint8_t> data2 = TraceBuffer("SECOND").get();
+    data.insert(data.end(), data2.begin(), data2.end());
+
+    std::vector<std::string> names;
+    EXPECT_TRUE(eSEL::renameTraceBuffers(
+        data.data(), data.size(), [&names](std::string_view name) {
+            names.emplace_back(name);
+            return "B" + std::to_string(names.size());
+        }));
+    ASSERT_EQ(2u, names.size());
+    EXPECT_EQ("FIRST", names[0]);
+    EXPECT_EQ("SECOND", names[1]);
+    EXPECT_STREQ("B1", reinterpret_cast<const char*>(&data[4]));
+    EXPECT_STREQ("B2", reinterpret_cast<const char*>(&data[data2.size() + 4]));
+
+    // Name is too long
+    EXPECT_FALSE(eSEL::renameTraceBuffers(
+        data.data(), data.size(),
+        [](std::string_view) { return std::string(17, 'x'); }));
+}
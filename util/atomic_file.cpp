@@ -0,0 +1,64 @@
+/**
+ * @brief Atomic replacement of files.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "atomic_file.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <system_error>
+
+void writeFileAtomically(const std::string& path,
+                         std::initializer_list<eSEL::ByteSpan> parts)
+{
+    std::string tmpPath = path + ".XXXXXX";
+    const int fd = mkostemp(&tmpPath[0], O_CLOEXEC);
+    if (fd == -1)
+        throw std::system_error(errno, std::system_category(), tmpPath);
+
+    for (const auto& it : parts)
+    {
+        const uint8_t* ptr = it.data();
+        size_t size = it.size();
+        while (size)
+        {
+            const ssize_t rc = write(fd, ptr, size);
+            if (rc == -1 && errno == EINTR)
+                continue;
+            if (rc == -1)
+            {
+                const int err = errno;
+                close(fd);
+                unlink(tmpPath.c_str());
+                throw std::system_error(err, std::system_category(), tmpPath);
+            }
+            ptr += rc;
+            size -= rc;
+        }
+    }
+    close(fd);
+
+    if (rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        const int err = errno;
+        unlink(tmpPath.c_str());
+        throw std::system_error(err, std::system_category(), path);
+    }
+}
@@ -0,0 +1,37 @@
+/**
+ * @brief Atomic replacement of files.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <byte_span.hpp>
+#include <initializer_list>
+#include <string>
+
+/**
+ * @brief Write file atomically.
+ *        Data is written to a temporary file in the same directory, which
+ *        then replaces the target, so readers never see partially written
+ *        data.
+ *
+ * @param[in] path - path to the file
+ * @param[in] parts - file content, written one by one
+ *
+ * @throws std::system_error in case of errors
+ */
+void writeFileAtomically(const std::string& path,
+                         std::initializer_list<eSEL::ByteSpan> parts);
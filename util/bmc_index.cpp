@@ -0,0 +1,325 @@
+/**
+ * @brief Index of BMC events.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bmc_index.hpp"
+
+#include "atomic_file.hpp"
+#include "input_file.hpp"
+#include "stream_scanner.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+/** @brief Magic signature of index file. */
+static constexpr char IndexMagic[8] = {'E', 'S', 'E', 'L', 'B', 'M', 'C', 0};
+/** @brief Version of index file format. */
+static constexpr uint32_t IndexVersion = 1;
+
+/**
+ * @struct IndexHeader
+ * @brief Header of index file, followed by array of records.
+ *        Host byte order is used, the index is local.
+ */
+struct IndexHeader
+{
+    char magic[sizeof(IndexMagic)]; ///< Magic signature
+    uint32_t version;               ///< Format version
+    uint32_t count;                 ///< Number of records
+    uint64_t dirSize;               ///< Size of directory path
+};
+
+/**
+ * @struct IndexRecord
+ * @brief Record of index file.
+ */
+struct IndexRecord
+{
+    uint64_t id;           ///< Event ID
+    BmcIndex::Entry entry; ///< Event file description
+};
+
+/**
+ * @brief Get event ID from file name.
+ *
+ * @param[in] name - name of the file
+ *
+ * @return event ID, 0 if the name is not a number
+ */
+static size_t eventId(const char* name)
+{
+    char* end;
+    const unsigned long id = strtoul(name, &end, 10);
+    return *end ? 0 : id;
+}
+
+BmcIndex::BmcIndex(const std::string& dir, const std::string& indexFile) :
+    dir_(dir), indexFile_(indexFile)
+{
+    if (indexFile_.empty())
+        return;
+
+    std::unique_ptr<InputFile> file;
+    try
+    {
+        file = std::make_unique<InputFile>(indexFile_.c_str());
+    }
+    catch (const std::system_error&)
+    {
+        return; // not created yet
+    }
+
+    const eSEL::ByteSpan content = file->content();
+    IndexHeader hdr;
+    if (content.size() < sizeof(hdr))
+        return;
+    memcpy(&hdr, content.data(), sizeof(hdr));
+    if (memcmp(hdr.magic, IndexMagic, sizeof(IndexMagic)) != 0 ||
+        hdr.version != IndexVersion || hdr.dirSize != dir_.size() ||
+        content.size() !=
+            sizeof(hdr) + hdr.dirSize + hdr.count * sizeof(IndexRecord) ||
+        memcmp(content.data() + sizeof(hdr), dir_.data(), dir_.size()) != 0)
+        return;
+
+    const uint8_t* ptr = content.data() + sizeof(hdr) + hdr.dirSize;
+    for (uint32_t i = 0; i < hdr.count; ++i, ptr += sizeof(IndexRecord))
+    {
+        IndexRecord rec;
+        memcpy(&rec, ptr, sizeof(rec));
+        entries_.emplace_hint(entries_.end(), rec.id, rec.entry);
+    }
+}
+
+void BmcIndex::refresh(const Callback& callback /*= nullptr*/)
+{
+    DIR* dir = opendir(dir_.c_str());
+    if (!dir)
+        throw std::system_error(errno, std::system_category(), dir_);
+
+    bool changed = false;
+    std::vector<size_t> found;
+    found.reserve(entries_.size());
+    while (const dirent* ent = readdir(dir))
+    {
+        size_t id;
+        const Entry* entry = update(dirfd(dir), ent->d_name, id);
+        if (entry)
+        {
+            changed = true;
+            if (callback)
+                callback(id, entry);
+        }
+        if (id)
+            found.push_back(id);
+    }
+    closedir(dir);
+
+    // Drop removed events
+    std::sort(found.begin(), found.end());
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+        if (std::binary_search(found.begin(), found.end(), it->first))
+            ++it;
+        else
+        {
+            const size_t id = it->first;
+            it = entries_.erase(it);
+            changed = true;
+            if (callback)
+                callback(id, nullptr);
+        }
+    }
+
+    if (changed)
+        save();
+}
+
+void BmcIndex::watch(const Callback& callback)
+{
+    const int fd = inotify_init1(IN_CLOEXEC);
+    if (fd == -1)
+    {
+        throw std::system_error(errno, std::system_category(),
+                                "Unable to initialize inotify");
+    }
+    if (inotify_add_watch(fd, dir_.c_str(),
+                          IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM |
+                              IN_DELETE) == -1)
+    {
+        const int err = errno;
+        close(fd);
+        throw std::system_error(err, std::system_category(), dir_);
+    }
+
+    // Events changed before the watch was set up
+    refresh(callback);
+
+    const int dirFd = open(dir_.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd == -1)
+    {
+        const int err = errno;
+        close(fd);
+        throw std::system_error(err, std::system_category(), dir_);
+    }
+
+    alignas(inotify_event) char buf[64 * 1024];
+    while (true)
+    {
+        const ssize_t len = read(fd, buf, sizeof(buf));
+        if (len == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            const int err = errno;
+            close(dirFd);
+            close(fd);
+            throw std::system_error(err, std::system_category(),
+                                    "Unable to read inotify events");
+        }
+
+        bool changed = false;
+        for (ssize_t pos = 0; pos < len;)
+        {
+            const inotify_event* ev =
+                reinterpret_cast<const inotify_event*>(buf + pos);
+            pos += sizeof(inotify_event) + ev->len;
+
+            if (ev->mask & IN_Q_OVERFLOW)
+            {
+                // Some events were lost, rescan the whole directory
+                refresh(callback);
+                continue;
+            }
+            if (!ev->len)
+                continue;
+
+            if (ev->mask & (IN_MOVED_FROM | IN_DELETE))
+            {
+                const size_t id = eventId(ev->name);
+                if (id && entries_.erase(id))
+                {
+                    changed = true;
+                    callback(id, nullptr);
+                }
+                continue;
+            }
+
+            size_t id;
+            const Entry* entry = update(dirFd, ev->name, id);
+            if (entry)
+            {
+                changed = true;
+                callback(id, entry);
+            }
+        }
+
+        if (changed)
+            save();
+    }
+}
+
+const BmcIndex::Entry* BmcIndex::update(int dirFd, const char* name,
+                                        size_t& id)
+{
+    id = eventId(name);
+    if (!id)
+        return nullptr;
+
+    struct stat st;
+    if (fstatat(dirFd, name, &st, 0) != 0 || !S_ISREG(st.st_mode))
+    {
+        id = 0;
+        return nullptr;
+    }
+
+    const auto it = entries_.find(id);
+    if (it != entries_.end() &&
+        it->second.size == static_cast<uint64_t>(st.st_size) &&
+        it->second.mtimeSec == st.st_mtim.tv_sec &&
+        it->second.mtimeNsec == st.st_mtim.tv_nsec)
+        return nullptr; // not changed
+
+    Entry entry{st.st_mtim.tv_sec, st.st_mtim.tv_nsec,
+                static_cast<uint64_t>(st.st_size), false};
+    try
+    {
+        StreamScanner scanner(name, dirFd);
+        entry.hasEsel = scanner.find(BmcEselToken);
+    }
+    catch (const std::system_error&)
+    {
+        // File was removed or can not be read, skip it
+        id = 0;
+        return nullptr;
+    }
+
+    return &(entries_[id] = entry);
+}
+
+void BmcIndex::save() const
+{
+    if (indexFile_.empty())
+        return;
+
+    // Records are zero-initialized, so padding bytes are defined
+    std::vector<IndexRecord> records(entries_.size());
+    auto rec = records.begin();
+    for (const auto& it : entries_)
+    {
+        rec->id = it.first;
+        rec->entry.mtimeSec = it.second.mtimeSec;
+        rec->entry.mtimeNsec = it.second.mtimeNsec;
+        rec->entry.size = it.second.size;
+        rec->entry.hasEsel = it.second.hasEsel;
+        ++rec;
+    }
+
+    IndexHeader hdr{};
+    memcpy(hdr.magic, IndexMagic, sizeof(IndexMagic));
+    hdr.version = IndexVersion;
+    hdr.count = static_cast<uint32_t>(records.size());
+    hdr.dirSize = dir_.size();
+
+    try
+    {
+        writeFileAtomically(
+            indexFile_,
+            {eSEL::ByteSpan(reinterpret_cast<const uint8_t*>(&hdr),
+                            sizeof(hdr)),
+             eSEL::ByteSpan(reinterpret_cast<const uint8_t*>(dir_.data()),
+                            dir_.size()),
+             eSEL::ByteSpan(reinterpret_cast<const uint8_t*>(records.data()),
+                            records.size() * sizeof(IndexRecord))});
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Unable to save index of BMC events: " << e.what()
+                  << std::endl;
+    }
+}
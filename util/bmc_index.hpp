@@ -0,0 +1,133 @@
+/**
+ * @brief Index of BMC events.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+
+/** @brief Token to search eSEL data inside BMC event. */
+static constexpr std::string_view BmcEselToken = "ESEL=";
+
+/**
+ * @class BmcIndex
+ * @brief Index of BMC event files.
+ *        The index keeps the state of each event file and whether it contains
+ *        eSEL. It can be saved to disk, so the next refresh reads only files
+ *        which size or modification time were changed.
+ */
+class BmcIndex
+{
+  public:
+    /**
+     * @struct Entry
+     * @brief Description of the event file.
+     */
+    struct Entry
+    {
+        int64_t mtimeSec;  ///< Modification time: seconds
+        int64_t mtimeNsec; ///< Modification time: nanoseconds
+        uint64_t size;     ///< Size of the file in bytes
+        bool hasEsel;      ///< File contains eSEL
+    };
+
+    /** @brief Entries: event ID -> entry. */
+    using Entries = std::map<size_t, Entry>;
+
+    /**
+     * @brief Callback to notify about changed event.
+     *
+     * @param[in] id - event ID
+     * @param[in] entry - new state of the event, nullptr if it was removed
+     */
+    using Callback = std::function<void(size_t id, const Entry* entry)>;
+
+    /**
+     * @brief Constructor: load saved index.
+     *        Invalid or outdated index file is ignored.
+     *
+     * @param[in] dir - path to the directory with event files
+     * @param[in] indexFile - path to the index file, empty to keep the
+     *                        index in memory only
+     */
+    BmcIndex(const std::string& dir, const std::string& indexFile);
+
+    /**
+     * @brief Refresh index: rescan changed files, drop removed ones.
+     *        The index file is updated if anything was changed.
+     *
+     * @param[in] callback - callback to notify about changed events, may be
+     *                       empty
+     *
+     * @throws std::system_error if directory can not be read
+     */
+    void refresh(const Callback& callback = nullptr);
+
+    /**
+     * @brief Watch the directory and keep the index up to date.
+     *        Never returns, except in case of errors.
+     *        Changes made since the last refresh are notified too, a file
+     *        may be notified again if it was rewritten.
+     *
+     * @param[in] callback - callback to notify about changed events
+     *
+     * @throws std::system_error in case of errors
+     */
+    void watch(const Callback& callback);
+
+    /**
+     * @brief Get index entries.
+     *
+     * @return entries
+     */
+    const Entries& entries() const
+    {
+        return entries_;
+    }
+
+  private:
+    /**
+     * @brief Update entry of the event file.
+     *        File is read only if its size or modification time changed.
+     *
+     * @param[in] dirFd - descriptor of the events directory
+     * @param[in] name - name of the event file
+     * @param[out] id - event ID
+     *
+     * @return pointer to the updated entry, nullptr if file is not an event
+     *         or it was not changed
+     */
+    const Entry* update(int dirFd, const char* name, size_t& id);
+
+    /**
+     * @brief Save index to the file.
+     *        Errors are reported to stderr, the index is kept in memory.
+     */
+    void save() const;
+
+  private:
+    /** @brief Path to the directory with event files. */
+    std::string dir_;
+    /** @brief Path to the index file. */
+    std::string indexFile_;
+    /** @brief Index entries. */
+    Entries entries_;
+};
@@ -0,0 +1,207 @@
+/**
+ * @brief Persistent cache of printed events.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_cache.hpp"
+
+#include "atomic_file.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <system_error>
+#include <vector>
+
+/** @brief Magic signature of cache entry file. */
+static constexpr char CacheMagic[8] = {'E', 'S', 'E', 'L', 'O', 'U', 'T', 0};
+/** @brief Version of cache entry format. */
+static constexpr uint32_t CacheVersion = 2;
+/** @brief Suffix of cache entry file. */
+static const char* CacheSuffix = ".eselcache";
+/** @brief Entries not used for this time are removed. */
+static constexpr std::chrono::hours CacheMaxAge(24 * 30);
+/** @brief Limit of total size of cache entries in bytes. */
+static constexpr uintmax_t CacheMaxSize = 64 * 1024 * 1024;
+
+/**
+ * @struct CacheHeader
+ * @brief Header of cache entry file, followed by context, raw eSEL data and
+ *        printed output. Host byte order is used, the cache is local.
+ */
+struct CacheHeader
+{
+    char magic[sizeof(CacheMagic)]; ///< Magic signature
+    uint32_t version;               ///< Format version
+    uint32_t contextSize;           ///< Size of context
+    uint64_t dataSize;              ///< Size of raw eSEL data
+    uint64_t outputSize;            ///< Size of printed output
+    uint64_t diagnosticsSize;       ///< Size of decoder warnings
+};
+
+EventCache::EventCache(const char* dir, std::string context) :
+    dir_(dir), context_(std::move(context))
+{
+    std::error_code ec;
+    std::filesystem::create_directories(dir_, ec);
+    if (ec)
+        throw std::system_error(ec, dir_);
+    prune();
+}
+
+EventCache::Entry EventCache::find(const eSEL::ByteSpan& data) const
+{
+    Entry entry;
+
+    std::unique_ptr<InputFile> file;
+    try
+    {
+        file = std::make_unique<InputFile>(entryPath(data).c_str());
+    }
+    catch (const std::system_error&)
+    {
+        return entry; // not cached
+    }
+
+    // Verify the entry, it may be damaged or have another key with the
+    // same hash
+    const eSEL::ByteSpan content = file->content();
+    CacheHeader hdr;
+    if (content.size() < sizeof(hdr))
+        return entry;
+    memcpy(&hdr, content.data(), sizeof(hdr));
+    if (memcmp(hdr.magic, CacheMagic, sizeof(CacheMagic)) != 0 ||
+        hdr.version != CacheVersion || hdr.contextSize != context_.size() ||
+        hdr.dataSize != data.size() ||
+        content.size() != sizeof(hdr) + hdr.contextSize + hdr.dataSize +
+                              hdr.outputSize + hdr.diagnosticsSize)
+        return entry;
+    const uint8_t* ptr = content.data() + sizeof(hdr);
+    if (memcmp(ptr, context_.data(), context_.size()) != 0)
+        return entry;
+    ptr += context_.size();
+    if (memcmp(ptr, data.data(), data.size()) != 0)
+        return entry;
+    ptr += data.size();
+
+    entry.output = std::string_view(reinterpret_cast<const char*>(ptr),
+                                    hdr.outputSize);
+    ptr += hdr.outputSize;
+    entry.diagnostics = std::string_view(reinterpret_cast<const char*>(ptr),
+                                         hdr.diagnosticsSize);
+    entry.file = std::move(file);
+
+    // Update modification time, it is used to find entries to remove
+    utimensat(AT_FDCWD, entryPath(data).c_str(), nullptr, 0);
+
+    return entry;
+}
+
+void EventCache::store(const eSEL::ByteSpan& data, std::string_view output,
+                       std::string_view diagnostics) const
+{
+    CacheHeader hdr;
+    memcpy(hdr.magic, CacheMagic, sizeof(CacheMagic));
+    hdr.version = CacheVersion;
+    hdr.contextSize = static_cast<uint32_t>(context_.size());
+    hdr.dataSize = data.size();
+    hdr.outputSize = output.size();
+    hdr.diagnosticsSize = diagnostics.size();
+
+    writeFileAtomically(
+        entryPath(data),
+        {eSEL::ByteSpan(reinterpret_cast<const uint8_t*>(&hdr), sizeof(hdr)),
+         eSEL::ByteSpan(reinterpret_cast<const uint8_t*>(context_.data()),
+                        context_.size()),
+         data,
+         eSEL::ByteSpan(reinterpret_cast<const uint8_t*>(output.data()),
+                        output.size()),
+         eSEL::ByteSpan(reinterpret_cast<const uint8_t*>(diagnostics.data()),
+                        diagnostics.size())});
+}
+
+void EventCache::prune() const
+{
+    namespace fs = std::filesystem;
+
+    struct Candidate
+    {
+        fs::path path;
+        fs::file_time_type mtime;
+        uintmax_t size;
+    };
+    std::vector<Candidate> entries;
+
+    const auto expired = fs::file_time_type::clock::now() - CacheMaxAge;
+    std::error_code ec;
+    for (fs::directory_iterator it(dir_, ec), end; !ec && it != end;
+         it.increment(ec))
+    {
+        // Temporary files of interrupted writes are expired as well
+        const fs::path& path = it->path();
+        const std::string name = path.filename().string();
+        if (name.find(CacheSuffix) == std::string::npos)
+            continue;
+        std::error_code fec;
+        const fs::file_time_type mtime = fs::last_write_time(path, fec);
+        const uintmax_t size = fs::file_size(path, fec);
+        if (fec)
+            continue;
+        if (mtime < expired)
+            fs::remove(path, fec);
+        else if (path.extension() == CacheSuffix)
+            entries.push_back({path, mtime, size});
+    }
+
+    uintmax_t total = 0;
+    for (const auto& it : entries)
+        total += it.size;
+    if (total <= CacheMaxSize)
+        return;
+
+    // Remove least recently used entries
+    std::sort(entries.begin(), entries.end(),
+              [](const Candidate& a, const Candidate& b) {
+                  return a.mtime < b.mtime;
+              });
+    for (const auto& it : entries)
+    {
+        if (total <= CacheMaxSize)
+            break;
+        std::error_code fec;
+        if (fs::remove(it.path, fec))
+            total -= it.size;
+    }
+}
+
+std::string EventCache::entryPath(const eSEL::ByteSpan& data) const
+{
+    const std::hash<std::string_view> hasher;
+    const size_t hash =
+        hasher(std::string_view(reinterpret_cast<const char*>(data.data()),
+                                data.size())) ^
+        (hasher(context_) * 0x9e3779b97f4a7c15ull);
+
+    char name[17];
+    snprintf(name, sizeof(name), "%016zx", hash);
+    return dir_ + '/' + name + CacheSuffix;
+}
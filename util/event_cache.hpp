@@ -0,0 +1,105 @@
+/**
+ * @brief Persistent cache of printed events.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "input_file.hpp"
+
+#include <byte_span.hpp>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * @class EventCache
+ * @brief Persistent cache of printed events.
+ *        Each entry is a file named by hash of raw eSEL data and context. The
+ *        file contains the key data used to verify the entry and the printed
+ *        output, which is mapped to memory and written as is.
+ */
+class EventCache
+{
+  public:
+    /**
+     * @struct Entry
+     * @brief Cached event.
+     */
+    struct Entry
+    {
+        std::unique_ptr<InputFile> file; ///< Mapped file, null if not found
+        std::string_view output;         ///< Printed event, refers to file
+        std::string_view diagnostics;    ///< Decoder warnings, refers to file
+    };
+
+    /**
+     * @brief Constructor.
+     *        Entries not used for a long time are removed, the oldest ones
+     *        are removed also while the cache exceeds its size limit.
+     *
+     * @param[in] dir - path to the cache directory, created if not exists
+     * @param[in] context - everything that affects printed output except
+     *                      eSEL data: setup identity and printer settings
+     *
+     * @throws std::system_error if directory can not be created
+     */
+    EventCache(const char* dir, std::string context);
+
+    /**
+     * @brief Find printed event.
+     *
+     * @param[in] data - raw eSEL data
+     *
+     * @return cache entry, file is null if the event is not cached
+     */
+    Entry find(const eSEL::ByteSpan& data) const;
+
+    /**
+     * @brief Save printed event.
+     *        Entry is replaced atomically, so concurrent processes never see
+     *        partially written data.
+     *
+     * @param[in] data - raw eSEL data
+     * @param[in] output - printed event
+     * @param[in] diagnostics - decoder warnings printed with the event
+     *
+     * @throws std::system_error in case of errors
+     */
+    void store(const eSEL::ByteSpan& data, std::string_view output,
+               std::string_view diagnostics) const;
+
+  private:
+    /**
+     * @brief Remove outdated entries and limit total size of the cache.
+     */
+    void prune() const;
+
+    /**
+     * @brief Get path to the entry file.
+     *
+     * @param[in] data - raw eSEL data
+     *
+     * @return path to the file
+     */
+    std::string entryPath(const eSEL::ByteSpan& data) const;
+
+  private:
+    /** @brief Path to the cache directory. */
+    std::string dir_;
+    /** @brief Context of cached entries. */
+    std::string context_;
+};
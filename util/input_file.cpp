@@ -0,0 +1,115 @@
+/**
+ * @brief Read-only input file.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "input_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+
+/**
+ * @class FileDescriptor
+ * @brief RAII wrapper for file descriptor.
+ */
+class FileDescriptor
+{
+  public:
+    explicit FileDescriptor(int fd) : fd_(fd)
+    {
+    }
+
+    ~FileDescriptor()
+    {
+        if (fd_ != -1)
+            close(fd_);
+    }
+
+    operator int() const
+    {
+        return fd_;
+    }
+
+  private:
+    int fd_;
+};
+
+InputFile::InputFile(const char* path) : map_(nullptr), mapSize_(0)
+{
+    FileDescriptor fd(open(path, O_RDONLY | O_CLOEXEC));
+    if (fd == -1)
+        throw std::system_error(errno, std::system_category(), path);
+
+    struct stat st;
+    if (fstat(fd, &st) == -1)
+        throw std::system_error(errno, std::system_category(), path);
+
+    // Procfs and sysfs files report zero size, read them as pipes
+    if (S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED)
+        {
+            map_ = map;
+            mapSize_ = st.st_size;
+            madvise(map_, mapSize_, MADV_SEQUENTIAL);
+            return;
+        }
+    }
+
+    read(fd, path);
+}
+
+InputFile::~InputFile()
+{
+    if (map_)
+        munmap(map_, mapSize_);
+}
+
+eSEL::ByteSpan InputFile::content() const
+{
+    if (map_)
+        return eSEL::ByteSpan(static_cast<const uint8_t*>(map_), mapSize_);
+    return eSEL::ByteSpan(buffer_.data(), buffer_.size());
+}
+
+void InputFile::read(int fd, const char* path)
+{
+    size_t size = 0;
+    buffer_.resize(64 * 1024);
+    while (true)
+    {
+        if (size == buffer_.size())
+            buffer_.resize(buffer_.size() * 2);
+        const ssize_t rc = ::read(fd, buffer_.data() + size,
+                                  buffer_.size() - size);
+        if (rc == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            throw std::system_error(errno, std::system_category(), path);
+        }
+        if (rc == 0)
+            break;
+        size += rc;
+    }
+    buffer_.resize(size);
+}
@@ -0,0 +1,71 @@
+/**
+ * @brief Read-only input file.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <byte_span.hpp>
+#include <vector>
+
+/**
+ * @class InputFile
+ * @brief Read-only input file.
+ *        Regular files are mapped to memory, so their content is never
+ *        copied. Other files (pipes, character devices, procfs) can not be
+ *        mapped and are read to the buffer.
+ */
+class InputFile
+{
+  public:
+    /**
+     * @brief Constructor: open the file.
+     *
+     * @param[in] path - path to the file
+     *
+     * @throws std::system_error in case of errors
+     */
+    explicit InputFile(const char* path);
+
+    ~InputFile();
+
+    InputFile(const InputFile&) = delete;
+    InputFile& operator=(const InputFile&) = delete;
+
+    /**
+     * @brief Get file content.
+     *
+     * @return view of the file content
+     */
+    eSEL::ByteSpan content() const;
+
+  private:
+    /**
+     * @brief Read file content to the buffer.
+     *
+     * @param[in] fd - file descriptor
+     * @param[in] path - path to the file, used for error messages
+     */
+    void read(int fd, const char* path);
+
+  private:
+    /** @brief Pointer to the mapped memory, nullptr if file is not mapped. */
+    void* map_;
+    /** @brief Size of the mapped memory. */
+    size_t mapSize_;
+    /** @brief Content of the file that can not be mapped. */
+    std::vector<uint8_t> buffer_;
+};
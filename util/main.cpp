@@ -17,6 +17,7 @@
  */
 
 #include "printer.hpp"
+#include "range.hpp"
 #include "task.hpp"
 
 #include <fcntl.h>
@@ -25,10 +26,12 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
 #include <setup.hpp>
+#include <thread>
 
 // Constant flags for getopt.
 // Used as id for long-only arguments.
@@ -40,7 +43,12 @@ enum
     OptFspTrace,
     OptOCCStr,
     OptHbStr,
-    OptHbSym
+    OptHbSym,
+    OptInputFormat,
+    OptBuildSymIdx,
+    OptTraceBatch,
+    OptCacheDir,
+    OptBmcWatch
 };
 
 /** @brief Print title with version info. */
@@ -66,12 +74,19 @@ static void printHelp(const char* app)
     std::cout <<
     "Input options:\n"
     "  -f, --file=FILE    Parse and print eSEL from specified file\n"
-    "  -b, --bmc=ID       Parse and print eSEL from BMC's event with specified ID\n"
+    "  -b, --bmc=ID       Parse and print eSEL from BMC's event with specified ID,\n"
+    "                     range of IDs (FIRST-LAST) or all events (all)\n"
     "      --bmc-list     Print list of BMC's events, that contain eSEL\n"
-    "  -p, --pnor=NUM     Parse and print eSEL with specified number from PNOR flash\n"
+    "      --bmc-watch    Print list of BMC's events, then wait for new events\n"
+    "  -p, --pnor=NUM     Parse and print eSEL with specified number from PNOR flash,\n"
+    "                     range of numbers (FIRST-LAST) or all events (all)\n"
     "      --pnor-list    Print list of events stored on PNOR flash\n"
     "      --hbel=FILE    Use file as HBEL partition instead of reading it from PNOR\n"
     "  -e, --ecc          Cut out ECC data from source file\n"
+    "      --input-format=FMT\n"
+    "                     Set format of source file:\n"
+    "                       bin    binary data, used by default\n"
+    "                       hex    hex text, e.g. output of ipmitool/busctl\n"
     "\n"
     "Output options:\n"
     "  -n, --number=NUM   Print only section with number NUM, this option  can be\n"
@@ -81,14 +96,24 @@ static void printHelp(const char* app)
     "                       long   long lines without splitting\n"
     "                       json   JSON output\n"
     "                       hex    hex dump of payload\n"
-    "                       bin    binary data of payload\n"
+    "                       bin    binary data of payload, not applicable for\n"
+    "                              range of events\n"
     "Parser setup:\n"
     "  --fsp-trace=FILE   Set path to FSP trace utility [" DEFAULT_FSP_TRACE "]\n"
     "  --occ-str=FILE     Set path to OCC string file [" DEFAULT_OCC_STRINGS "]\n"
     "  --hb-str=FILE      Set path to HostBoot string file [" DEFAULT_HB_STRINGS "]\n"
     "  --hb-sym=FILE      Set path to HostBoot symbols file [" DEFAULT_HB_SYMBOLS "]\n"
+    "  -j, --jobs=NUM     Set number of threads used to decode events [1]\n"
+    "      --trace-batch  Decode traces of all events by a single run of FSP\n"
+    "                     trace utility, applicable for range of events\n"
+    "      --cache-dir=DIR\n"
+    "                     Cache printed events in directory, unchanged events are\n"
+    "                     printed from cache without decoding\n"
     "\n"
     "Other options:\n"
+    "      --build-symidx=FILE\n"
+    "                     Build binary index of HostBoot symbols file, it is\n"
+    "                     used instead of the symbols file while up to date\n"
     "  -v, --version      Print version and exit\n"
     "  -h, --help         Print this help and exit\n";
     // clang-format on
@@ -100,21 +125,27 @@ int main(int argc, char* argv[])
     int optFlag = 0;
     // clang-format off
     const struct option opts[] = {
-        { "file",       required_argument, nullptr,  'f' },
-        { "bmc",        required_argument, nullptr,  'b' },
-        { "bmc-list",   no_argument,       &optFlag, OptBmcList },
-        { "pnor",       required_argument, nullptr,  'p' },
-        { "pnor-list",  no_argument,       &optFlag, OptPnorList },
-        { "hbel",       required_argument, &optFlag, OptHbelDump },
-        { "ecc",        no_argument,       nullptr,  'e' },
-        { "number",     required_argument, nullptr,  'n' },
-        { "output",     required_argument, nullptr,  'o' },
-        { "fsp-trace",  required_argument, &optFlag, OptFspTrace },
-        { "occ-str",    required_argument, &optFlag, OptOCCStr },
-        { "hb-str",     required_argument, &optFlag, OptHbStr },
-        { "hb-sym",     required_argument, &optFlag, OptHbSym },
-        { "version",    no_argument,       nullptr,  'v' },
-        { "help",       no_argument,       nullptr,  'h' },
+        { "file",         required_argument, nullptr,  'f' },
+        { "bmc",          required_argument, nullptr,  'b' },
+        { "bmc-list",     no_argument,       &optFlag, OptBmcList },
+        { "bmc-watch",    no_argument,       &optFlag, OptBmcWatch },
+        { "pnor",         required_argument, nullptr,  'p' },
+        { "pnor-list",    no_argument,       &optFlag, OptPnorList },
+        { "hbel",         required_argument, &optFlag, OptHbelDump },
+        { "ecc",          no_argument,       nullptr,  'e' },
+        { "input-format", required_argument, &optFlag, OptInputFormat },
+        { "number",       required_argument, nullptr,  'n' },
+        { "output",       required_argument, nullptr,  'o' },
+        { "fsp-trace",    required_argument, &optFlag, OptFspTrace },
+        { "occ-str",      required_argument, &optFlag, OptOCCStr },
+        { "hb-str",       required_argument, &optFlag, OptHbStr },
+        { "hb-sym",       required_argument, &optFlag, OptHbSym },
+        { "jobs",         required_argument, nullptr,  'j' },
+        { "trace-batch",  no_argument,       &optFlag, OptTraceBatch },
+        { "cache-dir",    required_argument, &optFlag, OptCacheDir },
+        { "build-symidx", required_argument, &optFlag, OptBuildSymIdx },
+        { "version",      no_argument,       nullptr,  'v' },
+        { "help",         no_argument,       nullptr,  'h' },
         { 0, 0, nullptr, 0 }
     };
     // clang-format on
@@ -146,29 +177,45 @@ int main(int argc, char* argv[])
                 task.fromFile(optarg);
                 break;
             case 'b':
-                try
-                {
-                    task.fromBmcEvent(std::stoul(optarg));
-                }
-                catch (std::exception&)
+            {
+                size_t first, last;
+                if (!parseRange(optarg, first, last))
                 {
                     std::cerr << "Invalid BMC event ID: " << optarg
                               << std::endl;
                     return EXIT_FAILURE;
                 }
+                task.fromBmcEvent(first, last);
                 break;
+            }
             case 'p':
-                try
+            {
+                size_t first, last;
+                if (!parseRange(optarg, first, last))
                 {
-                    task.fromPnorEvent(std::stoul(optarg));
+                    std::cerr << "Invalid PNOR event ID: " << optarg
+                              << std::endl;
+                    return EXIT_FAILURE;
                 }
-                catch (std::exception&)
+                task.fromPnorEvent(first, last);
+                break;
+            }
+            case 'j':
+            {
+                // More threads than a few per CPU only add overhead
+                const size_t maxJobs =
+                    4 * std::max(1u, std::thread::hardware_concurrency());
+                size_t jobs;
+                if (!parseNumber(optarg, jobs) || jobs > maxJobs)
                 {
-                    std::cerr << "Invalid PNOR event ID: " << optarg
+                    std::cerr << "Invalid number of jobs: " << optarg
+                              << ", expected number up to " << maxJobs
                               << std::endl;
                     return EXIT_FAILURE;
                 }
+                task.setJobs(jobs);
                 break;
+            }
             case 'n':
                 try
                 {
@@ -215,6 +262,9 @@ int main(int argc, char* argv[])
                     case OptBmcList:
                         task.listBmcEvent();
                         break;
+                    case OptBmcWatch:
+                        task.watchBmcEvent();
+                        break;
                     case OptPnorList:
                         task.listPnorEvent();
                         break;
@@ -233,6 +283,27 @@ int main(int argc, char* argv[])
                     case OptHbSym:
                         eSEL::setHostbootSymbols(optarg);
                         break;
+                    case OptBuildSymIdx:
+                        task.buildSymbolsIndex(optarg);
+                        break;
+                    case OptTraceBatch:
+                        task.setTraceBatch(true);
+                        break;
+                    case OptCacheDir:
+                        task.setCacheDir(optarg);
+                        break;
+                    case OptInputFormat:
+                        if (strcmp(optarg, "bin") == 0)
+                            task.sourceHexText(false);
+                        else if (strcmp(optarg, "hex") == 0)
+                            task.sourceHexText(true);
+                        else
+                        {
+                            std::cerr << "Invalid input format: " << optarg
+                                      << std::endl;
+                            return EXIT_FAILURE;
+                        }
+                        break;
                     default:
                         std::cerr << "Unsupported flag: " << optFlag
                                   << std::endl;
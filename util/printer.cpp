@@ -21,7 +21,7 @@
 #include <sys/ioctl.h>
 #include <unistd.h>
 
-#include <cstdio>
+#include <charconv>
 #include <hexdump.hpp>
 #include <iostream>
 
@@ -59,25 +59,100 @@ void Printer::addFilter(size_t num)
     sectionFilter_.insert(num);
 }
 
-void Printer::print(const eSEL::Event& event) const
+std::string Printer::settings() const
+{
+    std::string desc = std::to_string(format_);
+    desc += ':';
+    desc += std::to_string(maxColumns_);
+    for (size_t num : sectionFilter_)
+    {
+        desc += ':';
+        desc += std::to_string(num);
+    }
+    return desc;
+}
+
+void Printer::print(const eSEL::Event& event, std::ostream& os) const
+{
+    switch (format_)
+    {
+        case Table:
+        case Long:
+        case Hex:
+            printEventText(event, os);
+            break;
+        case Json:
+            printEventJson(event, os);
+            break;
+        case Bin:
+            printEventBin(event, os);
+            break;
+    }
+}
+
+Printer::Format Printer::format() const
+{
+    return format_;
+}
+
+bool Printer::decodes(size_t index) const
+{
+    switch (format_)
+    {
+        case Hex:
+        case Bin:
+            return false; // raw payload is printed
+        case Json:
+            return true; // filter is not applied
+        default:
+            return sectionFilter_.empty() ||
+                   sectionFilter_.find(index + 1) != sectionFilter_.end();
+    }
+}
+
+void Printer::printRangeBegin(std::ostream& os) const
+{
+    if (format_ == Json)
+        os << "[\n";
+}
+
+void Printer::printRangeEnd(std::ostream& os) const
+{
+    if (format_ == Json)
+        os << "\n]\n";
+}
+
+void Printer::printEntryBegin(const std::string& title, bool first,
+                              std::ostream& os) const
 {
     switch (format_)
     {
         case Table:
         case Long:
         case Hex:
-            printEventText(event);
+            os << title << ":\n";
             break;
         case Json:
-            printEventJson(event);
+        {
+            std::string line = first ? "{\n" : ",\n{\n";
+            line += "\"title\": ";
+            jsonEscape(line, title);
+            line += ",\n\"event\": ";
+            os << line;
             break;
+        }
         case Bin:
-            printEventBin(event);
             break;
     }
 }
 
-void Printer::printEventBin(const eSEL::Event& event) const
+void Printer::printEntryEnd(std::ostream& os) const
+{
+    if (format_ == Json)
+        os << "}";
+}
+
+void Printer::printEventBin(const eSEL::Event& event, std::ostream& os) const
 {
     const eSEL::Sections& sections = event.getSections();
     const size_t total = sections.size();
@@ -88,108 +163,129 @@ void Printer::printEventBin(const eSEL::Event& event) const
             continue; // Skip by filter
 
         const eSEL::Section::Payload& pl = sections[i]->payload();
-        fwrite(pl.data(), 1, pl.size(), stdout);
+        os.write(reinterpret_cast<const char*>(pl.data()), pl.size());
     }
 }
 
-void Printer::printEventJson(const eSEL::Event& event) const
+void Printer::printEventJson(const eSEL::Event& event, std::ostream& os) const
 {
-    std::cout << "{\n";
+    os << "{\n";
 
     // Print SEL record
     std::optional<eSEL::SelRecord> sel = event.getSelRecord();
     if (sel)
     {
-        std::cout << "  \"sel\": [\n";
-        printParametersJson(4, sel->params());
-        std::cout << "  ],\n";
+        os << "  \"sel\": [\n";
+        printParametersJson(4, sel->params(), os);
+        os << "  ],\n";
     }
 
     // Print event's sections
-    std::cout << "  \"sections\": [\n";
+    os << "  \"sections\": [\n";
     const eSEL::Sections& sections = event.getSections();
     const size_t total = sections.size();
     for (size_t i = 0; i < total; ++i)
     {
-        std::cout << "    {\n";
+        os << "    {\n";
 
         // Header
-        std::cout << "      \"header\": [\n";
-        printParametersJson(8, sections[i]->headerParams());
-        std::cout << "      ],\n";
+        os << "      \"header\": [\n";
+        printParametersJson(8, sections[i]->headerParams(), os);
+        os << "      ],\n";
 
         // Parameters
-        std::cout << "      \"params\": [\n";
-        printParametersJson(8, sections[i]->payloadParams());
-        std::cout << "      ]\n";
+        os << "      \"params\": [\n";
+        printParametersJson(8, sections[i]->payloadParams(), os);
+        os << "      ]\n";
 
-        std::cout << "    }";
+        os << "    }";
         if (i != total - 1)
-            std::cout << ",";
-        std::cout << "\n";
+            os << ",";
+        os << "\n";
     }
-    std::cout << "  ]\n";
+    os << "  ]\n";
 
-    std::cout << "}\n";
+    os << "}\n";
 }
 
-void Printer::printParametersJson(size_t indent,
-                                  const eSEL::Params& params) const
+void Printer::printParametersJson(size_t indent, const eSEL::Params& params,
+                                  std::ostream& os) const
 {
-    const std::string spaces(indent, ' ');
+    // Each line is built in a single buffer reused for all parameters
+    std::string line;
+    std::string value;
 
     const size_t total = params.size();
     for (size_t i = 0; i < total; ++i)
     {
         const eSEL::Param& param = params[i];
 
+        line.assign(indent, ' ');
+        value.clear();
+
         switch (param.type())
         {
             case eSEL::Param::Blank:
                 continue;
             case eSEL::Param::Header:
-                std::cout << spaces << "[\"header\", "
-                          << jsonEscape(param.value()) << "]";
+                line += "[\"header\", ";
+                param.appendValue(value);
+                jsonEscape(line, value);
+                line += ']';
                 break;
             case eSEL::Param::Raw:
-                std::cout << spaces << "[\"raw\", " << jsonEscape(param.value())
-                          << "]";
+                line += "[\"raw\", ";
+                param.appendValue(value);
+                jsonEscape(line, value);
+                line += ']';
                 break;
             case eSEL::Param::Boolean:
-                std::cout << spaces << "[" << jsonEscape(param.name()) << ", "
-                          << (std::get<bool>(param.variant()) ? "true"
-                                                              : "false")
-                          << "]";
+                line += '[';
+                jsonEscape(line, param.name());
+                line += ", ";
+                line += std::get<bool>(param.variant()) ? "true" : "false";
+                line += ']';
                 break;
             case eSEL::Param::String:
-                std::cout << spaces << "[" << jsonEscape(param.name()) << ", "
-                          << jsonEscape(param.value()) << "]";
+                line += '[';
+                jsonEscape(line, param.name());
+                line += ", ";
+                param.appendValue(value);
+                jsonEscape(line, value);
+                line += ']';
                 break;
             case eSEL::Param::Numeric:
-                std::cout << spaces << "[" << jsonEscape(param.name()) << ", ";
+                line += '[';
+                jsonEscape(line, param.name());
+                line += ", ";
                 std::visit(
-                    [](auto&& arg) {
+                    [&line](auto&& arg) {
                         using T = std::decay_t<decltype(arg)>;
                         if constexpr (std::is_arithmetic<T>::value)
-                            std::cout << std::to_string(arg);
+                        {
+                            char buf[24]; // enough for 64-bit decimal
+                            const auto rc = std::to_chars(
+                                buf, buf + sizeof(buf),
+                                static_cast<uint64_t>(arg));
+                            line.append(buf, rc.ptr);
+                        }
                         else
-                            std::cout << "null";
+                            line += "null";
                     },
                     param.variant());
-                std::cout << "]";
+                line += ']';
                 break;
         }
         if (i != total - 1)
-            std::cout << ",";
-        std::cout << "\n";
+            line += ',';
+        line += '\n';
+        os << line;
     }
 }
 
-std::string Printer::jsonEscape(const std::string& original) const
+void Printer::jsonEscape(std::string& out, std::string_view original) const
 {
-    std::string out;
-    out.reserve(original.length() + 2 /*quotes*/ + 16 /*reserve for escape*/);
-    out = "\"";
+    out += '"';
 
     for (char ch : original)
     {
@@ -228,10 +324,9 @@ std::string Printer::jsonEscape(const std::string& original) const
     }
 
     out += '"';
-    return out;
 }
 
-void Printer::printEventText(const eSEL::Event& event) const
+void Printer::printEventText(const eSEL::Event& event, std::ostream& os) const
 {
     static const std::string HeaderLine(maxColumns_, '=');
 
@@ -241,11 +336,11 @@ void Printer::printEventText(const eSEL::Event& event) const
         std::optional<eSEL::SelRecord> sel = event.getSelRecord();
         if (sel)
         {
-            std::cout << HeaderLine << "\n";
-            std::cout << "System Event Log (SEL) record\n";
-            std::cout << HeaderLine << "\n";
-            printParametersText(sel->params());
-            std::cout << "\n";
+            os << HeaderLine << "\n";
+            os << "System Event Log (SEL) record\n";
+            os << HeaderLine << "\n";
+            printParametersText(sel->params(), os);
+            os << "\n";
         }
     }
 
@@ -259,92 +354,96 @@ void Printer::printEventText(const eSEL::Event& event) const
             continue; // Skip by filter
 
         // Header
-        std::cout << HeaderLine << "\n";
-        std::cout << "Section " << (i + 1) << " of " << total << ": "
-                  << sections[i]->name() << "\n";
-        std::cout << HeaderLine << "\n";
-        printParametersText(sections[i]->headerParams());
+        os << HeaderLine << "\n";
+        os << "Section " << (i + 1) << " of " << total << ": "
+           << sections[i]->name() << "\n";
+        os << HeaderLine << "\n";
+        printParametersText(sections[i]->headerParams(), os);
 
         // Payload
         if (format_ != Hex)
         {
-            printParametersText(sections[i]->payloadParams());
+            printParametersText(sections[i]->payloadParams(), os);
         }
         else
         {
             const eSEL::Section::Payload& pl = sections[i]->payload();
-            std::cout << eSEL::hexDump(pl.data(), pl.size()) << "\n";
+            os << eSEL::hexDump(pl.data(), pl.size()) << "\n";
         }
 
-        std::cout << "\n"; // Blank line between sections
+        os << "\n"; // Blank line between sections
     }
 }
 
-void Printer::printParametersText(const eSEL::Params& params) const
+void Printer::printParametersText(const eSEL::Params& params,
+                                  std::ostream& os) const
 {
+    // Buffer for parameter's value, reused for all parameters
+    std::string value;
+
     for (const auto& param : params)
     {
+        value.clear();
+        param.appendValue(value);
+
         switch (param.type())
         {
             case eSEL::Param::Blank:
-                std::cout << "\n";
+                os << "\n";
                 break;
             case eSEL::Param::Header:
                 if (format_ == Long)
                 {
-                    std::cout << param.value() << "\n";
+                    os << value << "\n";
                 }
                 else
                 {
                     const size_t centered =
-                        param.value().length() > maxColumns_
+                        value.length() > maxColumns_
                             ? 0
-                            : maxColumns_ / 2 - param.value().length() / 2;
-                    std::cout << std::string(centered, ' ') << param.value()
-                              << "\n";
+                            : maxColumns_ / 2 - value.length() / 2;
+                    os << std::string(centered, ' ') << value << "\n";
                 }
                 break;
             case eSEL::Param::Raw:
                 if (format_ == Long)
                 {
-                    std::cout << param.value() << "\n";
+                    os << value << "\n";
                 }
                 else
                 {
-                    for (auto pos : split(param.value(), maxColumns_))
+                    for (auto pos : split(value, maxColumns_))
                     {
-                        std::cout << param.value().substr(pos.first, pos.second)
-                                  << "\n";
+                        os.write(value.data() + pos.first, pos.second);
+                        os << "\n";
                     }
                 }
                 break;
             default:
                 if (!param.name().empty())
-                    std::cout << param.name() << ":";
-                if (param.value().empty())
+                    os << param.name() << ":";
+                if (value.empty())
                 {
-                    std::cout << "\n";
+                    os << "\n";
                     continue;
                 }
                 if (param.name().empty())
-                    std::cout << param.name() << " ";
+                    os << param.name() << " ";
                 if (NameWidth > param.name().length())
                 {
-                    std::cout
-                        << std::string(NameWidth - param.name().length(), ' ');
+                    os << std::string(NameWidth - param.name().length(), ' ');
                 }
                 if (format_ == Long)
-                    std::cout << param.value() << "\n";
+                    os << value << "\n";
                 else
                 {
                     const int leftIndent = NameWidth + 1 /* delimiter ':' */;
-                    for (auto pos :
-                         split(param.value(), maxColumns_ - leftIndent))
+                    for (auto pos : split(value, maxColumns_ - leftIndent))
                     {
                         if (pos.first)
-                            std::cout << std::string(leftIndent, ' ');
-                        std::cout << param.value().substr(pos.first, pos.second)
-                                  << "\n";
+                            os << std::string(leftIndent, ' ');
+                        os.write(value.data() + pos.first, pos.second);
+                        os << "\n";
                     }
                 }
         }
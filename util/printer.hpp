@@ -19,7 +19,9 @@
 #pragma once
 
 #include <event.hpp>
+#include <iostream>
 #include <set>
+#include <string_view>
 
 /**
  * @class Printer
@@ -61,57 +63,122 @@ class Printer
     void addFilter(size_t num);
 
     /**
-     * @brief Print eSEL content to standart output.
+     * @brief Get description of settings that affect printed output.
+     *
+     * @return settings description
+     */
+    std::string settings() const;
+
+    /**
+     * @brief Print eSEL content.
      *
      * @param[in] eSEL - eSEL event
+     * @param[in] os - output stream
+     */
+    void print(const eSEL::Event& event, std::ostream& os = std::cout) const;
+
+    /**
+     * @brief Get output format.
+     *
+     * @return current output format
+     */
+    Format format() const;
+
+    /**
+     * @brief Check if decoded parameters of the section are printed.
+     *
+     * @param[in] index - index of the section in the event
+     *
+     * @return true if the section's payload has to be decoded
+     */
+    bool decodes(size_t index) const;
+
+    /**
+     * @brief Print beginning of events range.
+     *        In JSON format the range is an array of objects, each of them
+     *        contains the event title and the event itself.
+     *
+     * @param[in] os - output stream
+     */
+    void printRangeBegin(std::ostream& os = std::cout) const;
+
+    /**
+     * @brief Print end of events range.
+     *
+     * @param[in] os - output stream
      */
-    void print(const eSEL::Event& event) const;
+    void printRangeEnd(std::ostream& os = std::cout) const;
+
+    /**
+     * @brief Print title of the event in range, used to separate events.
+     *        The event printed after the title must be followed by
+     *        printEntryEnd() call.
+     *
+     * @param[in] title - title of the event
+     * @param[in] first - flag of the first event in range
+     * @param[in] os - output stream
+     */
+    void printEntryBegin(const std::string& title, bool first,
+                         std::ostream& os = std::cout) const;
+
+    /**
+     * @brief Print end of the event in range.
+     *
+     * @param[in] os - output stream
+     */
+    void printEntryEnd(std::ostream& os = std::cout) const;
 
   private:
     /**
      * @brief Print eSEL content in binary format (payload only).
      *
      * @param[in] eSEL - eSEL event
+     * @param[in] os - output stream
      */
-    void printEventBin(const eSEL::Event& event) const;
+    void printEventBin(const eSEL::Event& event, std::ostream& os) const;
 
     /**
      * @brief Print eSEL content in JSON format.
      *
      * @param[in] eSEL - eSEL event
+     * @param[in] os - output stream
      */
-    void printEventJson(const eSEL::Event& event) const;
+    void printEventJson(const eSEL::Event& event, std::ostream& os) const;
 
     /**
      * @brief Print parameters in JSON format.
      *
      * @param[in] indent - number of spaces used for indentation
      * @param[in] params - parameters array to print
+     * @param[in] os - output stream
      */
-    void printParametersJson(size_t indent, const eSEL::Params& params) const;
+    void printParametersJson(size_t indent, const eSEL::Params& params,
+                             std::ostream& os) const;
 
     /**
-     * @brief Escape JSON string.
+     * @brief Escape JSON string and append it to the buffer.
      *
+     * @param[in,out] out - buffer to append
      * @param[in] original - original text to escape
-     *
-     * @return escaped string
      */
-    std::string jsonEscape(const std::string& original) const;
+    void jsonEscape(std::string& out, std::string_view original) const;
 
     /**
      * @brief Print eSEL content in text/hex format.
      *
      * @param[in] eSEL - eSEL event
+     * @param[in] os - output stream
      */
-    void printEventText(const eSEL::Event& event) const;
+    void printEventText(const eSEL::Event& event, std::ostream& os) const;
 
     /**
      * @brief Print parameters as text.
      *
      * @param[in] params - parameters array to print
+     * @param[in] os - output stream
      */
-    void printParametersText(const eSEL::Params& params) const;
+    void printParametersText(const eSEL::Params& params,
+                             std::ostream& os) const;
 
     using Line = std::pair<size_t, size_t>;
 
@@ -0,0 +1,57 @@
+/**
+ * @brief Range of event IDs.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "range.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <string>
+
+bool parseNumber(const char* text, size_t& value)
+{
+    const char* end = text + strlen(text);
+    const std::from_chars_result rc = std::from_chars(text, end, value);
+    return rc.ec == std::errc() && rc.ptr == end;
+}
+
+bool parseRange(const char* text, size_t& first, size_t& last)
+{
+    // Maximum ID, std::string::npos is used as "not set" by the task
+    constexpr size_t maxId = std::string::npos - 1;
+
+    if (strcmp(text, "all") == 0)
+    {
+        first = 0;
+        last = maxId;
+        return true;
+    }
+
+    const char* end = text + strlen(text);
+    std::from_chars_result rc = std::from_chars(text, end, first);
+    if (rc.ec != std::errc())
+        return false;
+    last = first;
+    if (rc.ptr != end && *rc.ptr == '-')
+    {
+        rc = std::from_chars(rc.ptr + 1, end, last);
+        if (rc.ec != std::errc())
+            return false;
+    }
+
+    return rc.ptr == end && first <= last && last <= maxId;
+}
@@ -0,0 +1,44 @@
+/**
+ * @brief Range of event IDs.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Parse decimal number without sign or spaces.
+ *
+ * @param[in] text - text to parse
+ * @param[out] value - parsed number
+ *
+ * @return false if text has invalid format or the number is too big
+ */
+bool parseNumber(const char* text, size_t& value);
+
+/**
+ * @brief Parse range of event IDs.
+ *        IDs are decimal numbers without sign or spaces, "all" is parsed as
+ *        the range from 0 to the maximum ID.
+ *
+ * @param[in] text - text to parse: single ID, range "FIRST-LAST" or "all"
+ * @param[out] first - first ID of the range
+ * @param[out] last - last ID of the range (inclusive)
+ *
+ * @return false if text has invalid format
+ */
+bool parseRange(const char* text, size_t& first, size_t& last);
@@ -0,0 +1,133 @@
+/**
+ * @brief Sequential scanner of files.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stream_scanner.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Find token in the data.
+ *
+ * @param[in] data - data to search in
+ * @param[in] token - token to search, not empty
+ *
+ * @return position of the token or std::string_view::npos if not found
+ */
+static size_t findToken(std::string_view data, std::string_view token)
+{
+    if (data.size() < token.size())
+        return std::string_view::npos;
+    const size_t last = data.size() - token.size(); // last possible position
+    size_t pos = 0;
+
+#ifdef __SSE2__
+    // Check the first and the last characters of the token at 16 positions
+    // at once, compare the whole token only for candidates
+    const __m128i first = _mm_set1_epi8(token.front());
+    const __m128i tail = _mm_set1_epi8(token.back());
+    const size_t tailOffset = token.size() - 1;
+    for (; pos + 16 <= last + 1; pos += 16)
+    {
+        const __m128i head = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(data.data() + pos));
+        const __m128i end = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(data.data() + pos + tailOffset));
+        int mask = _mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(end, tail)));
+        while (mask)
+        {
+            const size_t candidate = pos + __builtin_ctz(mask);
+            if (memcmp(data.data() + candidate, token.data(),
+                       token.size()) == 0)
+                return candidate;
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    // Tail or non-SIMD build
+    return data.find(token, pos);
+}
+
+StreamScanner::StreamScanner(const char* path, int dirFd /*= -1*/) :
+    fd_(openat(dirFd == -1 ? AT_FDCWD : dirFd, path, O_RDONLY | O_CLOEXEC)),
+    buffer_(2 * BlockSize), begin_(0), end_(0)
+{
+    if (fd_ == -1)
+        throw std::system_error(errno, std::system_category(), path);
+}
+
+StreamScanner::~StreamScanner()
+{
+    close(fd_);
+}
+
+bool StreamScanner::find(std::string_view token)
+{
+    while (true)
+    {
+        const size_t pos = findToken(data(), token);
+        if (pos != std::string_view::npos)
+        {
+            consume(pos + token.size());
+            return true;
+        }
+        // Keep the tail, it can be the beginning of the token
+        if (end_ - begin_ >= token.size())
+            begin_ = end_ - token.size() + 1;
+        if (!read())
+            return false;
+    }
+}
+
+bool StreamScanner::read()
+{
+    // Move unconsumed data to the beginning of the buffer
+    const size_t size = end_ - begin_;
+    if (begin_)
+    {
+        memmove(buffer_.data(), buffer_.data() + begin_, size);
+        begin_ = 0;
+        end_ = size;
+    }
+    if (buffer_.size() - end_ < BlockSize)
+        buffer_.resize(end_ + BlockSize);
+
+    while (true)
+    {
+        const ssize_t rc = ::read(fd_, buffer_.data() + end_, BlockSize);
+        if (rc == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            throw std::system_error(errno, std::system_category(),
+                                    "Unable to read file");
+        }
+        end_ += rc;
+        return rc != 0;
+    }
+}
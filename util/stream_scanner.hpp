@@ -0,0 +1,101 @@
+/**
+ * @brief Sequential scanner of files.
+ *
+ * Copyright (c) 2019 YADRO
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class StreamScanner
+ * @brief Sequential scanner of file.
+ *        File is read by fixed-size blocks, so memory usage doesn't depend on
+ *        the file size. Unconsumed data of the current block is kept when the
+ *        next one is read.
+ */
+class StreamScanner
+{
+  public:
+    /** @brief Size of single read from the file. */
+    static constexpr size_t BlockSize = 64 * 1024;
+
+    /**
+     * @brief Constructor: open the file.
+     *
+     * @param[in] path - path to the file
+     * @param[in] dirFd - descriptor of the directory for relative path
+     *
+     * @throws std::system_error in case of errors
+     */
+    explicit StreamScanner(const char* path, int dirFd = -1);
+
+    ~StreamScanner();
+
+    StreamScanner(const StreamScanner&) = delete;
+    StreamScanner& operator=(const StreamScanner&) = delete;
+
+    /**
+     * @brief Skip data up to the end of the token.
+     *        Reading stops as soon as the token is found.
+     *
+     * @param[in] token - token to search, not empty
+     *
+     * @return false if the end of file is reached without the token
+     *
+     * @throws std::system_error in case of read errors
+     */
+    bool find(std::string_view token);
+
+    /**
+     * @brief Read the next block of the file.
+     *
+     * @return false if the end of file is reached
+     *
+     * @throws std::system_error in case of read errors
+     */
+    bool read();
+
+    /**
+     * @brief Get unconsumed data.
+     *
+     * @return view of the data
+     */
+    std::string_view data() const
+    {
+        return std::string_view(buffer_.data() + begin_, end_ - begin_);
+    }
+
+    /**
+     * @brief Mark data as consumed.
+     *
+     * @param[in] len - number of bytes to consume
+     */
+    void consume(size_t len)
+    {
+        begin_ += len;
+    }
+
+  private:
+    /** @brief File descriptor. */
+    int fd_;
+    /** @brief Data buffer. */
+    std::vector<char> buffer_;
+    /** @brief Start and end of unconsumed data in the buffer. */
+    size_t begin_, end_;
+};
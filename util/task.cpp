@@ -18,17 +18,30 @@
 
 #include "task.hpp"
 
+#include "bmc_index.hpp"
+#include "event_cache.hpp"
+#include "input_file.hpp"
+#include "stream_scanner.hpp"
+
 #include <endian.h>
-#include <sys/stat.h>
 
 #include <algorithm>
+#include <deque>
+#include <ecc.hpp>
+#include <event_batch.hpp>
 #include <filesystem>
 #include <fmtexcept.hpp>
-#include <fstream>
+#include <hex_text.hpp>
 #include <hexdump.hpp>
 #include <iomanip>
 #include <iostream>
+#include <optional>
+#include <sstream>
 #include <section_ph.hpp>
+#include <section_ud.hpp>
+#include <set>
+#include <setup.hpp>
+#include <thread_pool.hpp>
 
 /** @brief Size of HBEL partition on PNOR. */
 static constexpr int HbelPartitionSize = 0x24000;
@@ -36,13 +49,17 @@ static constexpr int HbelPartitionSize = 0x24000;
 static constexpr int HbelEventSize = 4096;
 /** @brief Path to BMC events. */
 static const char* BmcEventPath = "/var/lib/phosphor-logging/errors";
-/** @brief Token to search eSEL data inside BMC event. */
-static const uint8_t BmcEselToken[] = {'E', 'S', 'E', 'L', '='};
+/** @brief Minimal number of events parsed at once into a batch. */
+static constexpr size_t BatchEvents = 64;
+/** @brief Name of BMC events index file inside the cache directory. */
+static const char* BmcIndexFile = "bmc_events.idx";
 
 Task::Task(const Printer& printer) :
     action_(PrintSEL), printer_(printer), pelFile_(nullptr),
-    bmcEventId_(std::string::npos), pnorEventId_(std::string::npos),
-    eccExist_(false), hbelFile_(nullptr)
+    bmcFirst_(std::string::npos), bmcLast_(std::string::npos),
+    pnorFirst_(std::string::npos), pnorLast_(std::string::npos),
+    eccExist_(false), hexInput_(false), hbelFile_(nullptr), jobs_(1),
+    traceBatch_(false), cacheDir_(nullptr), symbolsFile_(nullptr)
 {
 }
 
@@ -51,14 +68,16 @@ void Task::fromFile(const char* path)
     pelFile_ = path;
 }
 
-void Task::fromBmcEvent(size_t eventId)
+void Task::fromBmcEvent(size_t first, size_t last)
 {
-    bmcEventId_ = eventId;
+    bmcFirst_ = first;
+    bmcLast_ = last;
 }
 
-void Task::fromPnorEvent(size_t eventId)
+void Task::fromPnorEvent(size_t first, size_t last)
 {
-    pnorEventId_ = eventId;
+    pnorFirst_ = first;
+    pnorLast_ = last;
     eccExist_ = true;
 }
 
@@ -67,12 +86,23 @@ void Task::listBmcEvent()
     action_ = PrintBmcList;
 }
 
+void Task::watchBmcEvent()
+{
+    action_ = WatchBmcList;
+}
+
 void Task::listPnorEvent()
 {
     action_ = PrintPnorList;
     eccExist_ = true;
 }
 
+void Task::buildSymbolsIndex(const char* path)
+{
+    action_ = BuildSymbolsIndex;
+    symbolsFile_ = path;
+}
+
 void Task::sourceWithEcc(bool eccExist)
 {
     eccExist_ = eccExist;
@@ -83,6 +113,26 @@ void Task::pnorHbel(const char* path)
     hbelFile_ = path;
 }
 
+void Task::sourceHexText(bool hexInput)
+{
+    hexInput_ = hexInput;
+}
+
+void Task::setJobs(size_t jobs)
+{
+    jobs_ = jobs ? jobs : 1;
+}
+
+void Task::setTraceBatch(bool traceBatch)
+{
+    traceBatch_ = traceBatch;
+}
+
+void Task::setCacheDir(const char* path)
+{
+    cacheDir_ = path;
+}
+
 int Task::execute()
 {
     int rc = EXIT_SUCCESS;
@@ -95,11 +145,21 @@ int Task::execute()
                 printEvent();
                 break;
             case PrintBmcList:
-                printBmcEventList();
+                printBmcEventList(false);
+                break;
+            case WatchBmcList:
+                printBmcEventList(true);
                 break;
             case PrintPnorList:
                 printPnorEventList();
                 break;
+            case BuildSymbolsIndex:
+            {
+                const std::string index =
+                    eSEL::buildHostbootSymbolsIndex(symbolsFile_);
+                std::cout << "Symbols index saved to " << index << std::endl;
+                break;
+            }
         }
     }
     catch (const eSEL::InvalidFormat& e)
@@ -123,27 +183,137 @@ int Task::execute()
     return rc;
 }
 
+/**
+ * @brief Describe problems found while decoding event's sections.
+ *        Sections are not decoded here, only decoded ones are described.
+ *
+ * @param[in] event - decoded event
+ * @param[out] text - problems description, line per problem
+ *
+ * @return true if decoding of any section failed
+ */
+static bool describeDiagnostics(const eSEL::Event& event, std::string& text)
+{
+    bool failed = false;
+    const eSEL::Sections& sections = event.getSections();
+    for (size_t i = 0; i < sections.size(); ++i)
+    {
+        const eSEL::Diagnostics& diag = sections[i]->diagnostics();
+        const std::string prefix = "Section " + std::to_string(i) + " (" +
+                                   sections[i]->name() + "): ";
+        for (const auto& it : diag.errors)
+            text += prefix + "Error: " + it + '\n';
+        for (const auto& it : diag.warnings)
+            text += prefix + "Warning: " + it + '\n';
+        failed |= !diag.errors.empty();
+    }
+    return failed;
+}
+
+/**
+ * @brief Print decoder diagnostics to stderr.
+ *
+ * @param[in] text - problems description, line per problem
+ * @param[in] title - title of the event, empty for single event
+ */
+static void printDiagnostics(std::string_view text, const std::string& title)
+{
+    while (!text.empty())
+    {
+        const size_t eol = text.find('\n');
+        const std::string_view line = text.substr(0, eol);
+        if (!title.empty())
+            std::cerr << title << ": ";
+        std::cerr << line << std::endl;
+        text.remove_prefix(eol == std::string_view::npos ? text.size()
+                                                         : eol + 1);
+    }
+}
+
 void Task::printEvent() const
 {
     std::vector<uint8_t> data;
+    // Binary file is parsed directly from the mapped memory
+    std::optional<InputFile> file;
+    eSEL::ByteSpan raw;
+
+    std::optional<EventCache> cache;
+    if (cacheDir_)
+    {
+        cache.emplace(cacheDir_,
+                      eSEL::getSetupIdentity() + printer_.settings());
+    }
+    const EventCache* cachePtr = cache ? &*cache : nullptr;
 
     if (pelFile_)
     {
-        data = readFile(pelFile_);
+        file.emplace(pelFile_);
+        raw = file->content();
+        if (hexInput_)
+        {
+            eSEL::decodeHexText(reinterpret_cast<const char*>(raw.data()),
+                                raw.size(), data);
+            raw = eSEL::ByteSpan(data.data(), data.size());
+        }
         if (eccExist_)
-            data = removeEcc(data);
+        {
+            data = removeEcc(raw);
+            raw = eSEL::ByteSpan(data.data(), data.size());
+        }
+    }
+    else if (bmcFirst_ != std::string::npos)
+    {
+        if (bmcFirst_ != bmcLast_)
+        {
+            printEvents("BMC event", getBmcEvents(bmcFirst_, bmcLast_),
+                        [this](size_t id) { return readBmcEvent(id); },
+                        cachePtr);
+            return;
+        }
+        data = readBmcEvent(bmcFirst_);
+        if (data.empty())
+        {
+            throw std::runtime_error(std::string("BMC event with ID ") +
+                                     std::to_string(bmcFirst_) +
+                                     " doesn't contain eSEL entry");
+        }
+    }
+    else if (pnorFirst_ != std::string::npos)
+    {
+        const std::vector<uint8_t> hbel = readHbel();
+        if (pnorFirst_ != pnorLast_)
+        {
+            printEvents("PNOR event",
+                        getPnorEvents(hbel, pnorFirst_, pnorLast_),
+                        [this, &hbel](size_t id) {
+                            return readPnorEvent(hbel, id);
+                        },
+                        cachePtr);
+            return;
+        }
+        data = readPnorEvent(hbel, pnorFirst_);
     }
-    else if (bmcEventId_ != std::string::npos)
-        data = readBmcEvent();
-    else if (pnorEventId_ != std::string::npos)
-        data = readPnorEvent();
     else
         throw std::runtime_error("Undefined eSEL source to read, exiting.");
 
+    if (!file)
+        raw = eSEL::ByteSpan(data.data(), data.size());
+
+    if (cache)
+    {
+        const EventCache::Entry entry = cache->find(raw);
+        if (entry.file)
+        {
+            printDiagnostics(entry.diagnostics, std::string());
+            std::cout.write(entry.output.data(), entry.output.size());
+            return;
+        }
+    }
+
     eSEL::Event event;
     try
     {
-        event.parse(data.data(), data.size());
+        event.parse(raw.data(), raw.size());
     }
     catch (const eSEL::InvalidFormat& e)
     {
@@ -151,139 +321,390 @@ void Task::printEvent() const
             throw;
         // Show warning and print the parsed part of the event
         std::cerr << "Invalid eSEL format: " << e.what() << std::endl;
+        cachePtr = nullptr; // partially parsed event is not cached
+    }
+    if (jobs_ > 1)
+    {
+        eSEL::ThreadPool pool(jobs_);
+        event.decode(pool, [this](size_t i) { return printer_.decodes(i); });
     }
-    printer_.print(event);
+    printAndCache(event, raw, cachePtr);
 }
 
-std::vector<uint8_t> Task::readFile(const char* path) const
+void Task::printAndCache(const eSEL::Event& event, const eSEL::ByteSpan& data,
+                         const EventCache* cache,
+                         const std::string& title /*= std::string()*/) const
 {
-    std::ifstream file(path, std::ios::in | std::ios::binary);
-    if (!file)
-        throw std::system_error(errno, std::system_category(), path);
+    std::string diagnostics;
+    if (!cache)
+    {
+        printer_.print(event);
+        describeDiagnostics(event, diagnostics);
+        printDiagnostics(diagnostics, title);
+        return;
+    }
 
-    std::vector<uint8_t> content;
+    std::ostringstream os;
+    printer_.print(event, os);
+    const std::string output = os.str();
 
-    std::copy(std::istreambuf_iterator<char>(file),
-              std::istreambuf_iterator<char>(), std::back_inserter(content));
+    // Only sections decoded by the printer have diagnostics
+    const bool failed = describeDiagnostics(event, diagnostics);
+    printDiagnostics(diagnostics, title);
+    // Failure may be temporary (missing or broken decoder setup)
+    if (failed)
+    {
+        std::cout << output;
+        return;
+    }
 
-    return content;
+    try
+    {
+        cache->store(data, output, diagnostics);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Unable to save event to cache: " << e.what()
+                  << std::endl;
+    }
+    std::cout << output;
 }
 
-std::vector<uint8_t> Task::removeEcc(const std::vector<uint8_t>& data) const
+/**
+ * @struct ChunkEvent
+ * @brief Event of the chunk read by worker thread.
+ */
+struct ChunkEvent
 {
-    std::vector<uint8_t> result;
+    std::vector<uint8_t> data; ///< Raw data, empty if there is no eSEL
+    EventCache::Entry cached;  ///< Cached output, the event is not parsed
+    const eSEL::EventBatch::Entry* parsed; ///< Parsed event, may be null
+    std::exception_ptr error;              ///< Error of reading the event
+};
 
-    const size_t len = data.size();
-    result.reserve(len - len / 9);
-    size_t i = 0;
-    for (uint8_t n : data)
+/**
+ * @brief Decode payloads of parsed event's sections.
+ *
+ * @param[in] event - event of the chunk
+ * @param[in] printer - printer of the event, selects sections to decode
+ *
+ * @throws std::exception if event can not be read or parsed
+ */
+static void decodeEvent(const ChunkEvent& event, const Printer& printer)
+{
+    if (event.error)
+        std::rethrow_exception(event.error);
+    if (!event.parsed)
+        return;
+
+    const eSEL::EventBatch::Entry& entry = *event.parsed;
+    const eSEL::Sections& sections = entry.event.getSections();
+    if (!entry.status && sections.empty())
+        eSEL::throwOnError(entry.status);
+    for (size_t i = 0; i < sections.size(); ++i)
     {
-        if (++i == 9)
-            i = 0;
-        else
-            result.push_back(n);
+        if (printer.decodes(i))
+            sections[i]->payloadParams();
     }
-
-    return result;
 }
 
-std::vector<uint8_t> Task::readBmcEvent() const
+void Task::printEvents(const char* source, const std::vector<size_t>& ids,
+                       const EventReader& reader,
+                       const EventCache* cache) const
 {
-    std::vector<uint8_t> eselRaw;
+    if (printer_.format() == Printer::Bin)
+    {
+        // Payloads of different events can not be separated in output
+        throw std::runtime_error(
+            "Binary output is not applicable for range of events");
+    }
 
-    // Read BMC event
-    const std::string eventFile =
-        BmcEventPath + std::string("/") + std::to_string(bmcEventId_);
-    const std::vector<uint8_t> eventData = readFile(eventFile.c_str());
+    eSEL::ThreadPool pool(jobs_);
+    // Number of events decoded in advance
+    const size_t maxQueued = pool.size() * 4;
+
+    // Events are handled by chunks: all events of a chunk are read, then
+    // parsed into one batch, its memory is released at once when the chunk
+    // is printed. In trace batching mode User Defined sections of the chunk
+    // are prepared at once.
+    const size_t chunkSize = std::max(maxQueued, BatchEvents);
+    eSEL::EventBatch batch;
+    std::vector<ChunkEvent> chunk;
+    size_t chunkStart = 0;
+    size_t chunkEnd = 0;
+    const auto readChunk = [&]() {
+        chunkStart = chunkEnd;
+        chunkEnd = std::min(ids.size(), chunkStart + chunkSize);
+        batch.clear();
+        chunk.clear();
+        chunk.resize(chunkEnd - chunkStart);
+        std::vector<std::future<void>> reading;
+        reading.reserve(chunk.size());
+        for (size_t i = 0; i < chunk.size(); ++i)
+        {
+            reading.emplace_back(pool.submit([&, i]() {
+                ChunkEvent& event = chunk[i];
+                try
+                {
+                    event.data = reader(ids[chunkStart + i]);
+                    if (cache && !event.data.empty())
+                    {
+                        event.cached = cache->find(eSEL::ByteSpan(
+                            event.data.data(), event.data.size()));
+                    }
+                }
+                catch (...)
+                {
+                    event.error = std::current_exception();
+                }
+            }));
+        }
+        for (auto& it : reading)
+            it.get();
+
+        // Events found in cache are not parsed
+        const auto parsable = [](const ChunkEvent& event) {
+            return !event.error && !event.data.empty() && !event.cached.file;
+        };
+        std::vector<eSEL::ByteSpan> buffers;
+        for (const auto& event : chunk)
+        {
+            if (parsable(event))
+                buffers.emplace_back(event.data.data(), event.data.size());
+        }
+        batch.parse(buffers);
+        const eSEL::EventBatch::Entries& entries = batch.getEvents();
+        size_t parsed = 0;
+        for (auto& event : chunk)
+        {
+            if (parsable(event))
+                event.parsed = &entries[parsed++];
+        }
 
-    auto it = std::search(eventData.begin(), eventData.end(), BmcEselToken,
-                          BmcEselToken + sizeof(BmcEselToken));
-    if (it != eventData.end())
+        if (traceBatch_)
+        {
+            std::vector<const eSEL::SectionUD*> sections;
+            for (const auto& entry : entries)
+            {
+                const eSEL::Sections& all = entry.event.getSections();
+                for (size_t i = 0; i < all.size(); ++i)
+                {
+                    const auto* ud =
+                        dynamic_cast<const eSEL::SectionUD*>(all[i].get());
+                    if (ud && printer_.decodes(i))
+                        sections.push_back(ud);
+                }
+            }
+            eSEL::SectionUD::prefetch(sections, pool);
+        }
+    };
+
+    std::deque<std::future<void>> queue;
+    size_t next = 0;
+    size_t failed = 0;
+    size_t printed = 0;
+    printer_.printRangeBegin();
+    while (next < ids.size() || !queue.empty())
     {
-        eselRaw.reserve(2048); // average size of eSEL
+        // Next chunk is read when the previous one is printed entirely
+        if (next == chunkEnd && queue.empty())
+            readChunk();
+
+        while (next < chunkEnd && queue.size() < maxQueued)
+        {
+            const ChunkEvent& event = chunk[next++ - chunkStart];
+            queue.emplace_back(pool.submit(
+                [this, &event]() { decodeEvent(event, printer_); }));
+        }
 
-        // Cut out ESEL property value and convert it from hex dump to binary
-        const uint8_t* eselPos = &*it + sizeof(BmcEselToken);
-        while (*eselPos)
+        const size_t num = next - queue.size();
+        const ChunkEvent& event = chunk[num - chunkStart];
+        const std::string title =
+            source + std::string(" ") + std::to_string(ids[num]);
+        try
         {
-            // Skip spaces
-            while (isspace(*eselPos))
-                ++eselPos;
-            if (!isxdigit(*eselPos))
-                break; // end of hex dump
-
-            // Convert 2-bytes text hex to numeric
-            uint8_t val = 0;
-            for (uint8_t hb = 0; hb <= 1; ++hb)
+            queue.front().get();
+            if (!event.data.empty())
             {
-                val <<= 4 * hb;
-                if (*eselPos >= '0' && *eselPos <= '9')
-                    val |= *eselPos - '0';
-                else if (*eselPos >= 'a' && *eselPos <= 'f')
-                    val |= 0x0a + *eselPos - 'a';
-                else if (*eselPos >= 'A' && *eselPos <= 'F')
-                    val |= 0x0a + *eselPos - 'A';
+                const bool partial = event.parsed && !event.parsed->status;
+                if (partial)
+                {
+                    std::cerr << title << ": Invalid eSEL format: "
+                              << eSEL::describe(event.parsed->status.error)
+                              << std::endl;
+                }
+                printer_.printEntryBegin(title, printed++ == 0);
+                if (event.cached.file)
+                {
+                    printDiagnostics(event.cached.diagnostics, title);
+                    std::cout.write(event.cached.output.data(),
+                                    event.cached.output.size());
+                }
                 else
-                    throw std::runtime_error("Invalid hex format");
-                ++eselPos;
+                {
+                    const eSEL::ByteSpan raw(event.data.data(),
+                                             event.data.size());
+                    printAndCache(event.parsed->event, raw,
+                                  partial ? nullptr : cache, title);
+                }
+                printer_.printEntryEnd();
             }
-            eselRaw.push_back(val);
         }
+        catch (const std::exception& e)
+        {
+            std::cerr << title << ": " << e.what() << std::endl;
+            ++failed;
+        }
+        queue.pop_front();
     }
+    printer_.printRangeEnd();
 
-    if (eselRaw.empty())
+    if (failed)
     {
-        throw std::runtime_error(std::string("BMC event with ID ") +
-                                 std::to_string(bmcEventId_) +
-                                 " doesn't contain eSEL entry");
+        throw std::runtime_error(std::string("Unable to decode ") +
+                                 std::to_string(failed) + " event(s)");
     }
-
-    return eselRaw;
 }
 
-void Task::printBmcEventList() const
+std::vector<uint8_t> Task::removeEcc(const eSEL::ByteSpan& data,
+                                     size_t slotSize /*= 0*/) const
 {
-    std::map<int, std::string> events;
-    for (auto& pathIt : std::filesystem::directory_iterator(BmcEventPath))
+    std::vector<uint8_t> result(eSEL::eccDataSize(data.size()));
+
+    const eSEL::EccStatus status =
+        eSEL::removeEcc(data.data(), data.size(), result.data());
+    if (status.corrected)
+    {
+        std::cerr << "Corrected ECC errors: " << status.corrected
+                  << std::endl;
+    }
+    for (size_t offset : status.uncorrectable)
     {
-        const std::filesystem::path& eventPath = pathIt.path();
-        const int id = atoi(eventPath.filename().c_str());
-        if (!id)
-            continue;
-
-        // Read BMC event
-        const std::vector<uint8_t> eventData = readFile(eventPath.c_str());
-        // Check for ESEL property
-        auto it = std::search(eventData.begin(), eventData.end(), BmcEselToken,
-                              BmcEselToken + sizeof(BmcEselToken));
-        if (it != eventData.end())
+        std::cerr << "Uncorrectable ECC error at offset 0x" << std::hex
+                  << offset << std::dec;
+        if (slotSize)
         {
-            // Get file timestamp, it will be used as a description
-            std::string timestamp;
-            struct stat s;
-            struct tm t;
-            if (!stat(eventPath.c_str(), &s) && localtime_r(&s.st_mtime, &t))
-            {
-                char buf[32]; // enough for "%x %X"
-                strftime(buf, sizeof(buf), "%x %X", &t);
-                timestamp = buf;
-            }
-            events.insert(std::make_pair(id, timestamp));
+            // Convert to slot number of data without ECC
+            std::cerr << " (event "
+                      << offset / eSEL::EccWordSize * (eSEL::EccWordSize - 1) /
+                             slotSize
+                      << ")";
         }
+        std::cerr << std::endl;
+    }
+
+    return result;
+}
+
+std::vector<size_t> Task::getBmcEvents(size_t first, size_t last) const
+{
+    std::vector<size_t> events;
+    for (auto& pathIt : std::filesystem::directory_iterator(BmcEventPath))
+    {
+        const int id = atoi(pathIt.path().filename().c_str());
+        if (id > 0 && static_cast<size_t>(id) >= first &&
+            static_cast<size_t>(id) <= last)
+            events.push_back(id);
     }
+    std::sort(events.begin(), events.end());
+    return events;
+}
+
+std::vector<uint8_t> Task::readBmcEvent(size_t eventId) const
+{
+    std::vector<uint8_t> eselRaw;
+
+    // Read BMC event
+    const std::string eventFile =
+        BmcEventPath + std::string("/") + std::to_string(eventId);
+    StreamScanner scanner(eventFile.c_str());
+    if (!scanner.find(BmcEselToken))
+        return eselRaw;
+
+    // Convert ESEL property value from hex dump to binary, block by block
+    bool more = true;
+    while (true)
+    {
+        const std::string_view text = scanner.data();
+        const size_t pos =
+            eSEL::decodeHexText(text.data(), text.size(), eselRaw, !more);
+        scanner.consume(pos);
+        // Stop at the end of hex text, incomplete byte is kept for the
+        // next block
+        if (!more || pos + 1 < text.size())
+            break;
+        more = scanner.read();
+    }
+
+    return eselRaw;
+}
+
+/**
+ * @brief Print entry of BMC events list.
+ *
+ * @param[in] id - event ID
+ * @param[in] entry - event file description
+ */
+static void printBmcListEntry(size_t id, const BmcIndex::Entry& entry)
+{
+    // File timestamp is used as a description
+    std::string timestamp;
+    struct tm t;
+    const time_t mtime = entry.mtimeSec;
+    if (localtime_r(&mtime, &t))
+    {
+        char buf[32]; // enough for "%x %X"
+        strftime(buf, sizeof(buf), "%x %X", &t);
+        timestamp = buf;
+    }
+    std::cout << std::setw(4) << id << "  " << timestamp << std::endl;
+}
+
+void Task::printBmcEventList(bool watch) const
+{
+    std::string indexFile;
+    if (cacheDir_)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(cacheDir_, ec);
+        indexFile = std::string(cacheDir_) + '/' + BmcIndexFile;
+    }
+    BmcIndex index(BmcEventPath, indexFile);
+    index.refresh();
 
     // Print event list
-    if (events.empty())
+    const BmcIndex::Entries& entries = index.entries();
+    const bool empty =
+        std::none_of(entries.begin(), entries.end(),
+                     [](const auto& it) { return it.second.hasEsel; });
+    if (empty && !watch)
         std::cout << "BMC doesn't contain event records with ESEL.\n";
     else
     {
         std::cout << "ID    Event file time stamp\n";
         std::cout << "----  ---------------------\n";
-        for (auto event : events)
+        for (const auto& it : entries)
+        {
+            if (it.second.hasEsel)
+                printBmcListEntry(it.first, it.second);
+        }
+    }
+
+    if (watch)
+    {
+        // Rewritten event files are notified again, print each event once
+        std::set<size_t> printed;
+        for (const auto& it : entries)
         {
-            std::cout << std::setw(4) << event.first << "  " << event.second
-                      << std::endl;
+            if (it.second.hasEsel)
+                printed.insert(it.first);
         }
+        index.watch([&printed](size_t id, const BmcIndex::Entry* entry) {
+            if (!entry)
+                printed.erase(id); // the ID may be reused by a new event
+            else if (entry->hasEsel && printed.insert(id).second)
+                printBmcListEntry(id, *entry);
+        });
     }
 }
 
@@ -294,41 +715,39 @@ std::vector<uint8_t> Task::readHbel() const
        skiboot source code and you can not build third party modules outside
        the skiboot tree. So, the partition will be read using console pflash
        utility instead of calling libflash.so. */
+    if (hbelFile_)
+        return removeEcc(InputFile(hbelFile_).content(), HbelEventSize);
+
     std::vector<uint8_t> data;
     data.reserve(HbelPartitionSize);
 
-    if (hbelFile_)
-        data = readFile(hbelFile_);
-    else
-    {
-        // Run pflash to read HBEL partition
-        FILE* pipeOut = popen(
-            "/usr/sbin/pflash -P HBEL -r /dev/stderr 2>&1 >/dev/null", "r");
-        if (!pipeOut)
-            throw std::system_error(errno, std::system_category(),
-                                    "Unable to open pflash pipe");
+    // Run pflash to read HBEL partition
+    FILE* pipeOut = popen(
+        "/usr/sbin/pflash -P HBEL -r /dev/stderr 2>&1 >/dev/null", "r");
+    if (!pipeOut)
+        throw std::system_error(errno, std::system_category(),
+                                "Unable to open pflash pipe");
 
-        // Read via pipe
-        char pipeData[512]; // arbitrary size
-        while (!feof(pipeOut))
+    // Read via pipe
+    char pipeData[512]; // arbitrary size
+    while (!feof(pipeOut))
+    {
+        const size_t rb = fread(pipeData, 1, sizeof(pipeData), pipeOut);
+        if (rb)
         {
-            const size_t rb = fread(pipeData, 1, sizeof(pipeData), pipeOut);
-            if (rb)
-            {
-                std::copy(pipeData, pipeData + rb, std::back_inserter(data));
-            }
+            std::copy(pipeData, pipeData + rb, std::back_inserter(data));
         }
+    }
 
-        // Check exit code
-        const int rc = pclose(pipeOut);
-        if (rc)
-        {
-            throw std::system_error(rc, std::system_category(),
-                                    "Failed to read HBEL partition");
-        }
+    // Check exit code
+    const int rc = pclose(pipeOut);
+    if (rc)
+    {
+        throw std::system_error(rc, std::system_category(),
+                                "Failed to read HBEL partition");
     }
 
-    return removeEcc(data);
+    return removeEcc(eSEL::ByteSpan(data.data(), data.size()), HbelEventSize);
 }
 
 void Task::printPnorEventList() const
@@ -337,7 +756,7 @@ void Task::printPnorEventList() const
 
     // Read HBEL and construct event list
     const std::vector<uint8_t> data = readHbel();
-    for (size_t i = 0; (i + 1) * HbelEventSize < data.size(); ++i)
+    for (size_t i = 0; (i + 1) * HbelEventSize <= data.size(); ++i)
     {
         const uint8_t* eventStart = &data[i * HbelEventSize];
 
@@ -368,15 +787,33 @@ void Task::printPnorEventList() const
     }
 }
 
-std::vector<uint8_t> Task::readPnorEvent() const
+std::vector<size_t> Task::getPnorEvents(const std::vector<uint8_t>& hbel,
+                                        size_t first, size_t last) const
 {
-    const std::vector<uint8_t> data = readHbel();
-    if ((pnorEventId_ + 1) * HbelEventSize > data.size())
+    std::vector<size_t> events;
+    for (size_t i = 0; (i + 1) * HbelEventSize <= hbel.size() && i <= last;
+         ++i)
+    {
+        // Check Private Header section existing
+        const uint16_t sid =
+            *reinterpret_cast<const uint16_t*>(&hbel[i * HbelEventSize]);
+        if (be16toh(sid) != eSEL::SectionPH::SectionId)
+            break;
+        if (i >= first)
+            events.push_back(i);
+    }
+    return events;
+}
+
+std::vector<uint8_t> Task::readPnorEvent(const std::vector<uint8_t>& hbel,
+                                         size_t eventId) const
+{
+    if ((eventId + 1) * HbelEventSize > hbel.size())
     {
         throw std::runtime_error(std::string("Event with ID ") +
-                                 std::to_string(pnorEventId_) +
+                                 std::to_string(eventId) +
                                  " not found in HBEL partition");
     }
-    const uint8_t* eventStart = &data[pnorEventId_ * HbelEventSize];
+    const uint8_t* eventStart = &hbel[eventId * HbelEventSize];
     return std::vector(eventStart, eventStart + HbelEventSize);
 }
@@ -18,8 +18,11 @@
 
 #pragma once
 
+#include "event_cache.hpp"
 #include "printer.hpp"
 
+#include <byte_span.hpp>
+#include <functional>
 #include <vector>
 
 /**
@@ -44,29 +47,44 @@ class Task
     void fromFile(const char* path);
 
     /**
-     * @brief Set task: Read, parse and print eSEL from BMC event.
+     * @brief Set task: Read, parse and print eSEL from BMC events.
      *
-     * @param[in] id - BMC event ID
+     * @param[in] first - first BMC event ID
+     * @param[in] last - last BMC event ID (inclusive)
      */
-    void fromBmcEvent(size_t eventId);
+    void fromBmcEvent(size_t first, size_t last);
 
     /**
      * @brief Set task: Read, parse and print eSEL from HBEL partition of PNOR.
      *
-     * @param[in] id - eSEL event ID
+     * @param[in] first - first eSEL event ID
+     * @param[in] last - last eSEL event ID (inclusive)
      */
-    void fromPnorEvent(size_t eventId);
+    void fromPnorEvent(size_t first, size_t last);
 
     /**
      * @brief Set task: Print list of events of BMC that contains eSEL.
      */
     void listBmcEvent();
 
+    /**
+     * @brief Set task: Print list of events of BMC that contains eSEL, then
+     *        watch for new events and print them.
+     */
+    void watchBmcEvent();
+
     /**
      * @brief Set task: Print list of events from HBEL partition of PNOR.
      */
     void listPnorEvent();
 
+    /**
+     * @brief Set task: Build binary index of HostBoot symbols file.
+     *
+     * @param[in] path - path to the symbols file
+     */
+    void buildSymbolsIndex(const char* path);
+
     /**
      * @brief Set ECC handling flag.
      *        If set, ECC bytes will be cut out from eSEL source.
@@ -75,6 +93,14 @@ class Task
      */
     void sourceWithEcc(bool eccExist);
 
+    /**
+     * @brief Set input format flag.
+     *        If set, source file contains hex text instead of binary data.
+     *
+     * @param[in] hexInput - flag indicated that source file is a hex text
+     */
+    void sourceHexText(bool hexInput);
+
     /**
      * @brief Switch to using dump of HBEL partition from file.
      *        By default, data is read from PNOR flash via pflash utility.
@@ -83,6 +109,33 @@ class Task
      */
     void pnorHbel(const char* path);
 
+    /**
+     * @brief Set number of threads used to decode events.
+     *
+     * @param[in] jobs - number of threads
+     */
+    void setJobs(size_t jobs);
+
+    /**
+     * @brief Set trace batching flag.
+     *        If set, events of range are parsed by chunks before decoding,
+     *        so traces that require FSP trace utility are decoded by its
+     *        single run per chunk instead of running it for each trace
+     *        section.
+     *
+     * @param[in] traceBatch - flag to enable batching
+     */
+    void setTraceBatch(bool traceBatch);
+
+    /**
+     * @brief Set directory to cache printed events.
+     *        Cached events are printed without decoding while the eSEL data,
+     *        setup and output settings are the same.
+     *
+     * @param[in] path - path to the cache directory
+     */
+    void setCacheDir(const char* path);
+
     /**
      * @brief Execute action.
      *
@@ -97,34 +150,80 @@ class Task
     void printEvent() const;
 
     /**
-     * @brief Read binary file.
+     * @brief Reader of event's raw data by its ID.
+     *        Returns empty array if event doesn't contain eSEL.
+     */
+    using EventReader = std::function<std::vector<uint8_t>(size_t)>;
+
+    /**
+     * @brief Parse and print multiple eSEL events.
+     *        Events are read and decoded in parallel, but printed in order.
+     *        Events are handled by chunks: all events of a chunk are parsed
+     *        into one memory arena. In batch mode trace sections of a chunk
+     *        are prepared at once.
      *
-     * @param[in] path - path to the file
+     * @param[in] source - name of the events source used in titles
+     * @param[in] ids - array of event IDs
+     * @param[in] reader - reader of event's raw data
+     * @param[in] cache - cache of printed events, may be nullptr
+     */
+    void printEvents(const char* source, const std::vector<size_t>& ids,
+                     const EventReader& reader, const EventCache* cache) const;
+
+    /**
+     * @brief Print event and save the output to cache.
+     *        Decoder diagnostics are printed to stderr and saved with the
+     *        output, events failed to decode are not saved.
      *
-     * @return file content
+     * @param[in] event - decoded event
+     * @param[in] data - raw eSEL data, used as a key of cache entry
+     * @param[in] cache - cache of printed events, may be nullptr
+     * @param[in] title - title of the event used in diagnostics
      */
-    std::vector<uint8_t> readFile(const char* path) const;
+    void printAndCache(const eSEL::Event& event, const eSEL::ByteSpan& data,
+                       const EventCache* cache,
+                       const std::string& title = std::string()) const;
 
     /**
-     * @brief Remove ECC (every 9th byte).
+     * @brief Verify and remove ECC (every 9th byte).
+     *        ECC errors are reported to stderr.
      *
      * @param[in] data - original data
+     * @param[in] slotSize - size of event's slot used to report errors, 0 if
+     *                       data is not split to slots
      *
      * @return data without ECC
      */
-    std::vector<uint8_t> removeEcc(const std::vector<uint8_t>& data) const;
+    std::vector<uint8_t> removeEcc(const eSEL::ByteSpan& data,
+                                   size_t slotSize = 0) const;
 
     /**
      * @brief Print list of events of BMC that contains eSEL.
+     *        Index of events is saved to the cache directory, if it is set,
+     *        so only changed event files are read next time.
+     *
+     * @param[in] watch - flag to watch for new events after printing list
+     */
+    void printBmcEventList(bool watch) const;
+
+    /**
+     * @brief Get IDs of BMC events in range.
+     *
+     * @param[in] first - first BMC event ID
+     * @param[in] last - last BMC event ID (inclusive)
+     *
+     * @return sorted array of event IDs
      */
-    void printBmcEventList() const;
+    std::vector<size_t> getBmcEvents(size_t first, size_t last) const;
 
     /**
      * @brief Read raw event data from BMC event.
      *
-     * @return unparsed raw data
+     * @param[in] eventId - BMC event ID
+     *
+     * @return unparsed raw data, empty if event doesn't contain eSEL
      */
-    std::vector<uint8_t> readBmcEvent() const;
+    std::vector<uint8_t> readBmcEvent(size_t eventId) const;
 
     /**
      * @brief Read HBEL partition on PNOR.
@@ -138,12 +237,28 @@ class Task
      */
     void printPnorEventList() const;
 
+    /**
+     * @brief Get IDs of events in HBEL partition.
+     *
+     * @param[in] hbel - HBEL data
+     * @param[in] first - first eSEL event ID
+     * @param[in] last - last eSEL event ID (inclusive)
+     *
+     * @return array of event IDs
+     */
+    std::vector<size_t> getPnorEvents(const std::vector<uint8_t>& hbel,
+                                      size_t first, size_t last) const;
+
     /**
      * @brief Read raw event data from PNOR.
      *
+     * @param[in] hbel - HBEL data
+     * @param[in] eventId - eSEL event ID
+     *
      * @return unparsed raw data
      */
-    std::vector<uint8_t> readPnorEvent() const;
+    std::vector<uint8_t> readPnorEvent(const std::vector<uint8_t>& hbel,
+                                       size_t eventId) const;
 
   private:
     /**
@@ -154,7 +269,9 @@ class Task
     {
         PrintSEL,
         PrintBmcList,
+        WatchBmcList,
         PrintPnorList,
+        BuildSymbolsIndex,
     };
     /** @brief General action type. */
     GeneralAction action_;
@@ -163,12 +280,22 @@ class Task
     const Printer& printer_;
     /** @brief Path to eSEL file. */
     const char* pelFile_;
-    /** @brief Event Id to read eSEL from BMC. */
-    size_t bmcEventId_;
-    /** @brief Event Id to read eSEL from PNOR. */
-    size_t pnorEventId_;
+    /** @brief First and last event Id to read eSEL from BMC. */
+    size_t bmcFirst_, bmcLast_;
+    /** @brief First and last event Id to read eSEL from PNOR. */
+    size_t pnorFirst_, pnorLast_;
     /** @brief Flag: ECC in source data. */
     bool eccExist_;
+    /** @brief Flag: source file is a hex text. */
+    bool hexInput_;
     /** @brief Path to HBEL dump file. */
     const char* hbelFile_;
+    /** @brief Number of threads used to decode events. */
+    size_t jobs_;
+    /** @brief Flag: decode traces of all events at once. */
+    bool traceBatch_;
+    /** @brief Path to the cache directory, nullptr if cache is disabled. */
+    const char* cacheDir_;
+    /** @brief Path to HostBoot symbols file to build index. */
+    const char* symbolsFile_;
 };